@@ -0,0 +1,125 @@
+/*
+MIT License
+
+Copyright (c) 2025 RealTimeChris (Chris M)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "RT-TM Library"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+This file was independently created by RealTimeChris (Chris M), without reuse
+or derivation from any codebase owned by other entities, including any contract work.
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT
+OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#pragma once
+
+#include <rt_tm/common/memory_buffer.hpp>
+#include <rt_tm/common/allocator.hpp>
+#include <rt_tm/common/common.hpp>
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+namespace rt_tm {
+
+	// An intermediate tensor's size and the inclusive range of op indices during which it must stay alive.
+	struct tensor_lifetime {
+		uint64_t byte_size{};
+		uint64_t first_op{};
+		uint64_t last_op{};
+
+		RT_TM_FORCE_INLINE constexpr bool overlaps(const tensor_lifetime& other) const noexcept {
+			return first_op <= other.last_op && other.first_op <= last_op;
+		}
+	};
+
+	struct activation_plan {
+		std::vector<uint64_t> offsets{};
+		uint64_t peak_bytes{};
+		uint64_t naive_bytes{};
+		uint64_t alignment{};
+	};
+
+	// Greedy-by-size placement: the largest tensors are placed first, each at the lowest aligned offset that does not
+	// collide with an already placed tensor whose lifetime overlaps its own.
+	struct activation_planner {
+		inline static constexpr uint64_t default_alignment{ 64 };
+
+		RT_TM_INLINE static activation_plan plan(const std::vector<tensor_lifetime>& lifetimes, uint64_t alignment = default_alignment) {
+			activation_plan return_value{};
+			return_value.alignment = alignment;
+			return_value.offsets.resize(lifetimes.size());
+			std::vector<size_t> order(lifetimes.size());
+			std::iota(order.begin(), order.end(), size_t{});
+			std::stable_sort(order.begin(), order.end(), [&](size_t lhs, size_t rhs) {
+				return lifetimes[lhs].byte_size > lifetimes[rhs].byte_size;
+			});
+			std::vector<size_t> placed{};
+			std::vector<size_t> conflicts{};
+			placed.reserve(lifetimes.size());
+			for (size_t index: order) {
+				const tensor_lifetime& current{ lifetimes[index] };
+				const uint64_t size{ roundUpToMultiple(current.byte_size, alignment) };
+				return_value.naive_bytes += size;
+				conflicts.clear();
+				for (size_t other: placed) {
+					if (current.overlaps(lifetimes[other])) {
+						conflicts.emplace_back(other);
+					}
+				}
+				std::sort(conflicts.begin(), conflicts.end(), [&](size_t lhs, size_t rhs) {
+					return return_value.offsets[lhs] < return_value.offsets[rhs];
+				});
+				uint64_t offset{};
+				for (size_t other: conflicts) {
+					const uint64_t other_offset{ return_value.offsets[other] };
+					if (offset + size <= other_offset) {
+						break;
+					}
+					offset = std::max(offset, roundUpToMultiple(other_offset + lifetimes[other].byte_size, alignment));
+				}
+				return_value.offsets[index] = offset;
+				return_value.peak_bytes		= std::max(return_value.peak_bytes, offset + size);
+				placed.emplace_back(index);
+			}
+			return return_value;
+		}
+	};
+
+	// One memory_buffer sized to a plan's peak; tensor x lives at the plan's static offset x for the whole graph.
+	template<global_config config> struct activation_arena {
+		RT_TM_FORCE_INLINE activation_arena(const activation_plan& plan_new)
+			: peak_bytes{ plan_new.peak_bytes }, naive_bytes{ plan_new.naive_bytes }, buffer{ std::max(plan_new.peak_bytes, plan_new.alignment) }, offsets{ plan_new.offsets } {
+			base = buffer.claim_memory(std::max(plan_new.peak_bytes, plan_new.alignment));
+		}
+
+		RT_TM_FORCE_INLINE uint8_t* operator[](size_t index) const noexcept {
+			return base + offsets[index];
+		}
+
+		RT_TM_FORCE_INLINE size_t size() const noexcept {
+			return offsets.size();
+		}
+
+		const uint64_t peak_bytes{};
+		const uint64_t naive_bytes{};
+
+	  protected:
+		memory_buffer<config, uint8_t> buffer;
+		std::vector<uint64_t> offsets{};
+		uint8_t* base{};
+	};
+
+}
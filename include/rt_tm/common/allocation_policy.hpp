@@ -0,0 +1,200 @@
+/*
+MIT License
+
+Copyright (c) 2025 RealTimeChris (Chris M)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "RT-TM Library"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+This file was independently created by RealTimeChris (Chris M), without reuse
+or derivation from any codebase owned by other entities, including any contract work.
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT
+OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#pragma once
+
+#include <rt_tm/common/allocator.hpp>
+#include <rt_tm/common/common.hpp>
+#include <rt_tm/common/numa.hpp>
+#include <source_location>
+#include <memory_resource>
+#include <unordered_map>
+#include <string_view>
+#include <utility>
+#include <mutex>
+#include <map>
+#include <new>
+#include <vector>
+
+namespace rt_tm {
+
+	// 2 MiB-aligned memory backed by explicit or transparent huge pages.
+	struct huge_page_policy {
+		RT_TM_FORCE_INLINE static void* allocate(size_t byte_count, size_t, std::source_location = std::source_location::current()) noexcept {
+			bool explicit_huge_pages{};
+			return alloc_wrapper<uint8_t>::allocate_huge_pages(byte_count, explicit_huge_pages);
+		}
+
+		RT_TM_FORCE_INLINE static void deallocate(void* ptr, size_t byte_count) noexcept {
+			alloc_wrapper<uint8_t>::deallocate_huge_pages(static_cast<uint8_t*>(ptr), byte_count);
+		}
+	};
+
+	// Pages bound to the node of the allocating thread, so pinned workers get local memory regardless of who touches it.
+	struct numa_local_policy {
+		RT_TM_FORCE_INLINE static void* allocate(size_t byte_count, size_t, std::source_location = std::source_location::current()) noexcept {
+			uint8_t* ptr{ alloc_wrapper<uint8_t>::allocate_pages(byte_count) };
+			bind_pages_to_os_node(ptr, byte_count, get_current_node());
+			return ptr;
+		}
+
+		RT_TM_FORCE_INLINE static void deallocate(void* ptr, size_t byte_count) noexcept {
+			alloc_wrapper<uint8_t>::deallocate_pages(static_cast<uint8_t*>(ptr), byte_count);
+		}
+	};
+
+	struct allocation_site_stats {
+		std::string_view file_name{};
+		std::string_view function_name{};
+		uint32_t line{};
+		uint64_t live_bytes{};
+		uint64_t peak_bytes{};
+		uint64_t allocation_count{};
+	};
+
+	// Process-wide record of live and peak bytes per allocating call site.
+	class allocation_tracker {
+	  public:
+		RT_TM_FORCE_INLINE static allocation_tracker& get() noexcept {
+			static allocation_tracker tracker{};
+			return tracker;
+		}
+
+		// Throws std::bad_alloc if the bookkeeping cannot grow, in which case no bytes have been recorded.
+		RT_TM_INLINE void record_allocation(const void* ptr, uint64_t byte_count, std::source_location location) {
+			std::unique_lock lock{ mutex };
+			const std::pair key{ std::string_view{ location.file_name() }, location.line() };
+			auto iterator = site_indices.find(key);
+			if (iterator == site_indices.end()) {
+				sites.emplace_back(allocation_site_stats{ location.file_name(), location.function_name(), location.line() });
+				try {
+					iterator = site_indices.emplace(key, sites.size() - 1).first;
+				} catch (...) {
+					sites.pop_back();
+					throw;
+				}
+			}
+			live_allocations[ptr] = std::pair{ iterator->second, byte_count };
+			allocation_site_stats& site{ sites[iterator->second] };
+			site.live_bytes += byte_count;
+			site.peak_bytes = std::max(site.peak_bytes, site.live_bytes);
+			++site.allocation_count;
+			live_bytes += byte_count;
+			peak_bytes = std::max(peak_bytes, live_bytes);
+		}
+
+		RT_TM_INLINE void record_deallocation(const void* ptr) {
+			std::unique_lock lock{ mutex };
+			if (auto iterator = live_allocations.find(ptr); iterator != live_allocations.end()) {
+				sites[iterator->second.first].live_bytes -= iterator->second.second;
+				live_bytes -= iterator->second.second;
+				live_allocations.erase(iterator);
+			}
+		}
+
+		RT_TM_INLINE std::vector<allocation_site_stats> get_sites() const {
+			std::unique_lock lock{ mutex };
+			return sites;
+		}
+
+		RT_TM_INLINE uint64_t get_live_bytes() const {
+			std::unique_lock lock{ mutex };
+			return live_bytes;
+		}
+
+		RT_TM_INLINE uint64_t get_peak_bytes() const {
+			std::unique_lock lock{ mutex };
+			return peak_bytes;
+		}
+
+	  protected:
+		std::map<std::pair<std::string_view, uint32_t>, size_t> site_indices{};
+		std::unordered_map<const void*, std::pair<size_t, uint64_t>> live_allocations{};
+		std::vector<allocation_site_stats> sites{};
+		mutable std::mutex mutex{};
+		uint64_t live_bytes{};
+		uint64_t peak_bytes{};
+	};
+
+	// Forwards to base_policy and records every allocation against its call site in allocation_tracker.
+	template<allocation_policy_type base_policy = aligned_heap_policy> struct tracking_policy {
+		RT_TM_INLINE static void* allocate(size_t byte_count, size_t alignment, std::source_location location = std::source_location::current()) noexcept {
+			void* ptr{ base_policy::allocate(byte_count, alignment, location) };
+			if (ptr) {
+				try {
+					allocation_tracker::get().record_allocation(ptr, byte_count, location);
+				} catch (const std::bad_alloc&) {
+					base_policy::deallocate(ptr, byte_count);
+					return nullptr;
+				}
+			}
+			return ptr;
+		}
+
+		RT_TM_INLINE static void deallocate(void* ptr, size_t byte_count) noexcept {
+			allocation_tracker::get().record_deallocation(ptr);
+			base_policy::deallocate(ptr, byte_count);
+		}
+	};
+
+	template<allocator_policy policy> struct allocation_policy_selector {
+		using type = aligned_heap_policy;
+	};
+
+	template<> struct allocation_policy_selector<allocator_policy::huge_pages> {
+		using type = huge_page_policy;
+	};
+
+	template<> struct allocation_policy_selector<allocator_policy::numa_local> {
+		using type = numa_local_policy;
+	};
+
+	template<> struct allocation_policy_selector<allocator_policy::tracking> {
+		using type = tracking_policy<>;
+	};
+
+	template<global_config config> using config_allocation_policy = typename allocation_policy_selector<config.allocator>::type;
+
+	// Exposes a policy as a std::pmr::memory_resource for pmr containers.
+	template<allocation_policy_type policy_type> class policy_memory_resource : public std::pmr::memory_resource {
+	  protected:
+		void* do_allocate(size_t byte_count, size_t alignment) override {
+			void* ptr{ policy_type::allocate(byte_count, alignment) };
+			if (!ptr) {
+				throw std::bad_alloc{};
+			}
+			return ptr;
+		}
+
+		void do_deallocate(void* ptr, size_t byte_count, size_t) override {
+			policy_type::deallocate(ptr, byte_count);
+		}
+
+		bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+			return this == &other;
+		}
+	};
+
+}
@@ -24,11 +24,101 @@
 #pragma once
 
 #include <rt_tm/cpu/detect_isa.hpp>
+#include <rt_tm/common/memory_accounting.hpp>
 #include <rt_tm/common/config.hpp>
+#include <source_location>
 #include <memory_resource>
+#include <concepts>
+#include <string_view>
+#include <charconv>
+#include <fstream>
+#include <string>
+
+#if defined(RT_TM_PLATFORM_WINDOWS)
+	#if !defined(NOMINMAX)
+		#define NOMINMAX
+	#endif
+	#if !defined(WIN32_LEAN_AND_MEAN)
+		#define WIN32_LEAN_AND_MEAN
+	#endif
+	#include <windows.h>
+#else
+	#include <sys/mman.h>
+	#include <unistd.h>
+#endif
 
 namespace rt_tm {
 
+	RT_TM_FORCE_INLINE size_t get_page_size() noexcept {
+#if defined(RT_TM_PLATFORM_WINDOWS)
+		SYSTEM_INFO system_info{};
+		GetSystemInfo(&system_info);
+		return static_cast<size_t>(system_info.dwPageSize);
+#else
+		return static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#endif
+	}
+
+	// Asks the kernel to start reading the pages backing [ptr, ptr + size) ahead of their first touch.
+	RT_TM_FORCE_INLINE void prefetch_pages(const void* ptr, size_t size) noexcept {
+		if (!ptr || size == 0) {
+			return;
+		}
+		const size_t page_size{ get_page_size() };
+		const uintptr_t begin{ reinterpret_cast<uintptr_t>(ptr) & ~(page_size - 1) };
+		const size_t length{ reinterpret_cast<uintptr_t>(ptr) + size - begin };
+#if defined(RT_TM_PLATFORM_WINDOWS)
+	#if defined(_WIN32_WINNT) && _WIN32_WINNT >= 0x0602
+		WIN32_MEMORY_RANGE_ENTRY entry{ reinterpret_cast<void*>(begin), length };
+		PrefetchVirtualMemory(GetCurrentProcess(), 1, &entry, 0);
+	#endif
+#else
+		madvise(reinterpret_cast<void*>(begin), length, MADV_WILLNEED);
+#endif
+	}
+
+	// Pins the pages backing [ptr, ptr + size) in RAM so they cannot be evicted.
+	RT_TM_FORCE_INLINE bool lock_pages(const void* ptr, size_t size) noexcept {
+		if (!ptr || size == 0) {
+			return false;
+		}
+#if defined(RT_TM_PLATFORM_WINDOWS)
+		return VirtualLock(const_cast<void*>(ptr), size) != 0;
+#else
+		return mlock(ptr, size) == 0;
+#endif
+	}
+
+	// Bytes of the mapping containing ptr that the kernel currently backs with transparent huge pages.
+	RT_TM_INLINE size_t get_huge_page_bytes(const void* ptr) {
+#if defined(RT_TM_PLATFORM_LINUX)
+		std::ifstream smaps{ "/proc/self/smaps" };
+		const uintptr_t address{ reinterpret_cast<uintptr_t>(ptr) };
+		bool in_mapping{};
+		std::string line{};
+		while (std::getline(smaps, line)) {
+			uintptr_t begin{};
+			uintptr_t end{};
+			const char* line_end{ line.data() + line.size() };
+			auto [begin_ptr, begin_ec] = std::from_chars(line.data(), line_end, begin, 16);
+			if (begin_ec == std::errc{} && begin_ptr < line_end && *begin_ptr == '-') {
+				auto [end_ptr, end_ec] = std::from_chars(begin_ptr + 1, line_end, end, 16);
+				in_mapping			   = end_ec == std::errc{} && address >= begin && address < end;
+				static_cast<void>(end_ptr);
+			} else if (in_mapping && std::string_view{ line }.starts_with("AnonHugePages:")) {
+				size_t kilobytes{};
+				std::string_view value{ line };
+				value.remove_prefix(value.find_first_not_of(' ', sizeof("AnonHugePages:") - 1));
+				std::from_chars(value.data(), value.data() + value.size(), kilobytes);
+				return kilobytes * 1024;
+			}
+		}
+#else
+		static_cast<void>(ptr);
+#endif
+		return 0;
+	}
+
 	template<typename value_type> RT_TM_FORCE_INLINE constexpr value_type roundUpToMultiple(value_type value, value_type multiple) noexcept {
 		if ((multiple & (multiple - 1)) == 0) {
 			auto mulSub1{ multiple - 1 };
@@ -40,7 +130,32 @@ namespace rt_tm {
 		}
 	}
 
-	template<typename value_type_new> class alloc_wrapper {
+	// The default allocation policy: heap memory aligned for the detected SIMD tier.
+	struct aligned_heap_policy {
+		RT_TM_FORCE_INLINE static void* allocate(size_t byte_count, size_t alignment, std::source_location = std::source_location::current()) noexcept {
+#if defined(RT_TM_PLATFORM_WINDOWS) || defined(RT_TM_PLATFORM_LINUX)
+			return _mm_malloc(roundUpToMultiple(byte_count, alignment), alignment);
+#else
+			return aligned_alloc(alignment, roundUpToMultiple(byte_count, alignment));
+#endif
+		}
+
+		RT_TM_FORCE_INLINE static void deallocate(void* ptr, size_t) noexcept {
+#if defined(RT_TM_PLATFORM_WINDOWS) || defined(RT_TM_PLATFORM_LINUX)
+			_mm_free(ptr);
+#else
+			free(ptr);
+#endif
+		}
+	};
+
+	template<typename policy_type>
+	concept allocation_policy_type = requires(void* ptr, size_t byte_count, std::source_location location) {
+		{ policy_type::allocate(byte_count, byte_count, location) } -> std::same_as<void*>;
+		{ policy_type::deallocate(ptr, byte_count) } -> std::same_as<void>;
+	};
+
+	template<typename value_type_new, allocation_policy_type policy_type = aligned_heap_policy> class alloc_wrapper {
 	  public:
 		using value_type	   = value_type_new;
 		using pointer		   = value_type_new*;
@@ -49,41 +164,94 @@ namespace rt_tm {
 		using const_reference  = const value_type_new&;
 		using size_type		   = std::size_t;
 		using difference_type  = std::ptrdiff_t;
-		using allocator_traits = std::allocator_traits<alloc_wrapper<value_type>>;
+		using allocator_traits = std::allocator_traits<alloc_wrapper<value_type, policy_type>>;
+		using policy		   = policy_type;
 
 		template<typename U> struct rebind {
-			using other = alloc_wrapper<U>;
+			using other = alloc_wrapper<U, policy_type>;
 		};
 
 		RT_TM_FORCE_INLINE alloc_wrapper() noexcept = default;
 
-		template<typename U> alloc_wrapper(const alloc_wrapper<U>&) noexcept {
+		template<typename U> alloc_wrapper(const alloc_wrapper<U, policy_type>&) noexcept {
 		}
 
-		RT_TM_FORCE_INLINE static pointer allocate(size_type count) noexcept {
+		RT_TM_FORCE_INLINE static pointer allocate(size_type count, std::source_location location = std::source_location::current()) noexcept {
 			if RT_TM_UNLIKELY (count == 0) {
 				return nullptr;
 			}
-			size_t alignment{ alignments[cpu_arch_index_holder::cpu_arch_index] };
-#if defined(RT_TM_PLATFORM_WINDOWS) || defined(RT_TM_PLATFORM_LINUX)
-			return static_cast<value_type*>(_mm_malloc(roundUpToMultiple(count * sizeof(value_type), alignment), alignment));
+			return static_cast<pointer>(policy_type::allocate(count * sizeof(value_type), alignments[cpu_arch_index_holder::cpu_arch_index], location));
+		}
+
+		RT_TM_FORCE_INLINE void deallocate(pointer ptr, size_t count = 0) noexcept {
+			if RT_TM_LIKELY (ptr) {
+				policy_type::deallocate(ptr, count * sizeof(value_type));
+			}
+		}
+
+		template<typename... arg_types> RT_TM_FORCE_INLINE static void construct(pointer ptr, arg_types&&... args) noexcept {
+			new (ptr) value_type(std::forward<arg_types>(args)...);
+		}
+
+		inline static constexpr size_t huge_page_size{ 2 * 1024 * 1024 };
+
+		// Allocates 2 MiB-aligned memory, preferring explicit huge pages (hugetlbfs / MEM_LARGE_PAGES) and
+		// otherwise requesting transparent huge pages; explicit_huge_pages reports which one was granted. The mapping
+		// is counted in memory_accounting's mapped bytes until deallocate_huge_pages.
+		RT_TM_INLINE static pointer allocate_huge_pages(size_type count, bool& explicit_huge_pages) noexcept {
+			explicit_huge_pages = false;
+			if RT_TM_UNLIKELY (count == 0) {
+				return nullptr;
+			}
+			const size_t byte_count{ roundUpToMultiple(count * sizeof(value_type), huge_page_size) };
+			pointer return_value{ map_huge_pages(byte_count, explicit_huge_pages) };
+			if (return_value) {
+				memory_accounting::get().add_mapped_bytes(static_cast<int64_t>(byte_count));
+			}
+			return return_value;
+		}
+
+		RT_TM_FORCE_INLINE static void deallocate_huge_pages(pointer ptr, size_type count) noexcept {
+			if RT_TM_LIKELY (ptr) {
+				const size_t byte_count{ roundUpToMultiple(count * sizeof(value_type), huge_page_size) };
+#if defined(RT_TM_PLATFORM_WINDOWS)
+				VirtualFree(ptr, 0, MEM_RELEASE);
 #else
-			return static_cast<value_type*>(aligned_alloc(alignment, roundUpToMultiple(count * sizeof(value_type), alignment)));
+				munmap(ptr, byte_count);
 #endif
+				memory_accounting::get().add_mapped_bytes(-static_cast<int64_t>(byte_count));
+			}
 		}
 
-		RT_TM_FORCE_INLINE void deallocate(pointer ptr, size_t = 0) noexcept {
-			if RT_TM_LIKELY (ptr) {
-#if defined(RT_TM_PLATFORM_WINDOWS) || defined(RT_TM_PLATFORM_LINUX)
-				_mm_free(ptr);
+		// Page-aligned anonymous memory with no pages committed yet, so a placement policy can be applied before first
+		// touch. Like the huge pages, it counts toward memory_accounting's mapped bytes.
+		RT_TM_INLINE static pointer allocate_pages(size_type count) noexcept {
+			if RT_TM_UNLIKELY (count == 0) {
+				return nullptr;
+			}
+			const size_t byte_count{ roundUpToMultiple(count * sizeof(value_type), get_page_size()) };
+#if defined(RT_TM_PLATFORM_WINDOWS)
+			pointer return_value{ static_cast<pointer>(VirtualAlloc(nullptr, byte_count, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE)) };
 #else
-				free(ptr);
+			void* ptr = mmap(nullptr, byte_count, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+			pointer return_value{ ptr == MAP_FAILED ? nullptr : static_cast<pointer>(ptr) };
 #endif
+			if (return_value) {
+				memory_accounting::get().add_mapped_bytes(static_cast<int64_t>(byte_count));
 			}
+			return return_value;
 		}
 
-		template<typename... arg_types> RT_TM_FORCE_INLINE static void construct(pointer ptr, arg_types&&... args) noexcept {
-			new (ptr) value_type(std::forward<arg_types>(args)...);
+		RT_TM_FORCE_INLINE static void deallocate_pages(pointer ptr, size_type count) noexcept {
+			if RT_TM_LIKELY (ptr) {
+				const size_t byte_count{ roundUpToMultiple(count * sizeof(value_type), get_page_size()) };
+#if defined(RT_TM_PLATFORM_WINDOWS)
+				VirtualFree(ptr, 0, MEM_RELEASE);
+#else
+				munmap(ptr, byte_count);
+#endif
+				memory_accounting::get().add_mapped_bytes(-static_cast<int64_t>(byte_count));
+			}
 		}
 
 		RT_TM_FORCE_INLINE static size_type maxSize() noexcept {
@@ -93,6 +261,42 @@ namespace rt_tm {
 		RT_TM_FORCE_INLINE static void destroy(pointer ptr) noexcept {
 			ptr->~value_type();
 		}
+
+	  protected:
+		RT_TM_INLINE static pointer map_huge_pages(size_t byte_count, bool& explicit_huge_pages) noexcept {
+#if defined(RT_TM_PLATFORM_WINDOWS)
+			if (const size_t large_page_minimum = GetLargePageMinimum(); large_page_minimum > 0 && byte_count % large_page_minimum == 0) {
+				if (void* ptr = VirtualAlloc(nullptr, byte_count, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE); ptr) {
+					explicit_huge_pages = true;
+					return static_cast<pointer>(ptr);
+				}
+			}
+			return static_cast<pointer>(VirtualAlloc(nullptr, byte_count, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE));
+#else
+	#if defined(MAP_HUGETLB)
+			if (void* ptr = mmap(nullptr, byte_count, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0); ptr != MAP_FAILED) {
+				explicit_huge_pages = true;
+				return static_cast<pointer>(ptr);
+			}
+	#endif
+			void* ptr = mmap(nullptr, byte_count + huge_page_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+			if (ptr == MAP_FAILED) {
+				return nullptr;
+			}
+			const uintptr_t begin{ reinterpret_cast<uintptr_t>(ptr) };
+			const uintptr_t aligned_begin{ roundUpToMultiple<uintptr_t>(begin, huge_page_size) };
+			if (aligned_begin > begin) {
+				munmap(ptr, aligned_begin - begin);
+			}
+			if (const size_t tail = begin + byte_count + huge_page_size - (aligned_begin + byte_count); tail > 0) {
+				munmap(reinterpret_cast<void*>(aligned_begin + byte_count), tail);
+			}
+	#if defined(MADV_HUGEPAGE)
+			madvise(reinterpret_cast<void*>(aligned_begin), byte_count, MADV_HUGEPAGE);
+	#endif
+			return reinterpret_cast<pointer>(aligned_begin);
+#endif
+		}
 	};
 
 }// namespace internal
\ No newline at end of file
@@ -66,8 +66,26 @@ namespace rt_tm {
 		gpu = 1,
 	};
 
+	enum class residency_mode {
+		none	   = 0,
+		locked	   = 1,
+		huge_pages = 2,
+	};
+
+	enum class allocator_policy {
+		aligned_heap = 0,
+		huge_pages	 = 1,
+		numa_local	 = 2,
+		tracking	 = 3,
+	};
+
     struct global_config {
 		bool exceptions{};
+		bool use_mmap{ true };
+		bool telemetry{};
+		residency_mode residency{};
+		bool numa{};
+		allocator_policy allocator{};
     };
 
 	struct cli_params {
@@ -27,6 +27,7 @@ OR OTHER DEALINGS IN THE SOFTWARE.
 
 #include <rt_tm/op_graph.hpp>
 #include <rt_tm/common/model_parser.hpp>
+#include <rt_tm/common/weight_cache.hpp>
 #include <rt_tm/common/common.hpp>
 #include <cstdint>
 
@@ -38,8 +39,12 @@ namespace rt_tm {
 			return model_parser<config, format>::parse_model(path);
 		}
 
-		RT_TM_FORCE_INLINE static op_graph<config> create_op_graph(op_graph_config, const model_graph&) {
-			return {};
+		RT_TM_FORCE_INLINE static weight_cache_telemetry load_weight_cache(model_graph& graph, const std::filesystem::path& path) {
+			return weight_cache<config>::load_or_create(graph, path);
+		}
+
+		RT_TM_FORCE_INLINE static op_graph<config> create_op_graph(op_graph_config graph_config, const model_graph&) {
+			return op_graph<config>{ graph_config };
 		}
 
 		RT_TM_FORCE_INLINE static cli_params parse_cli_arguments(const std::string& command_line) {
@@ -25,11 +25,29 @@ OR OTHER DEALINGS IN THE SOFTWARE.
 */
 #pragma once
 
+#include <rt_tm/common/memory_accounting.hpp>
 #include <rt_tm/common/common.hpp>
 #include <filesystem>
 #include <stdexcept>
+#include <iostream>
 #include <cstdint>
 #include <fstream>
+#include <string>
+
+#if defined(RT_TM_PLATFORM_WINDOWS)
+	#if !defined(NOMINMAX)
+		#define NOMINMAX
+	#endif
+	#if !defined(WIN32_LEAN_AND_MEAN)
+		#define WIN32_LEAN_AND_MEAN
+	#endif
+	#include <windows.h>
+#else
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+	#include <fcntl.h>
+#endif
 
 namespace rt_tm {
 
@@ -70,6 +88,10 @@ namespace rt_tm {
 			return contents;
 		}
 
+		const char* data() const noexcept {
+			return contents.data();
+		}
+
 		size_t size() const noexcept {
 			return contents.size();
 		}
@@ -78,6 +100,111 @@ namespace rt_tm {
 		std::string contents;
 	};
 
+	template<bool exceptions> class memory_mapped_file {
+	  public:
+		explicit memory_mapped_file(const std::filesystem::path& filePath) {
+			if (!std::filesystem::exists(filePath)) {
+				if constexpr (exceptions) {
+					throw std::runtime_error("File does not exist: " + filePath.string());
+				} else {
+					std::cerr << "File does not exist: " + filePath.string() << std::endl;
+					return;
+				}
+			}
+#if defined(RT_TM_PLATFORM_WINDOWS)
+			file_handle = CreateFileW(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+			LARGE_INTEGER file_size{};
+			if (file_handle == INVALID_HANDLE_VALUE || !GetFileSizeEx(file_handle, &file_size)) {
+				if constexpr (exceptions) {
+					throw std::runtime_error("Failed to open file: " + filePath.string());
+				} else {
+					std::cerr << "Failed to open file: " + filePath.string() << std::endl;
+					return;
+				}
+			}
+			size_val = static_cast<size_t>(file_size.QuadPart);
+			if (size_val == 0) {
+				return;
+			}
+			mapping_handle = CreateFileMappingW(file_handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+			if (mapping_handle) {
+				data_val = static_cast<const char*>(MapViewOfFile(mapping_handle, FILE_MAP_READ, 0, 0, 0));
+			}
+#else
+			int32_t file_descriptor = open(filePath.c_str(), O_RDONLY);
+			struct stat file_stat {};
+			if (file_descriptor == -1 || fstat(file_descriptor, &file_stat) != 0) {
+				if (file_descriptor != -1) {
+					close(file_descriptor);
+				}
+				if constexpr (exceptions) {
+					throw std::runtime_error("Failed to open file: " + filePath.string());
+				} else {
+					std::cerr << "Failed to open file: " + filePath.string() << std::endl;
+					return;
+				}
+			}
+			size_val = static_cast<size_t>(file_stat.st_size);
+			if (size_val == 0) {
+				close(file_descriptor);
+				return;
+			}
+			void* mapped_ptr = mmap(nullptr, size_val, PROT_READ, MAP_SHARED, file_descriptor, 0);
+			close(file_descriptor);
+			if (mapped_ptr != MAP_FAILED) {
+				data_val = static_cast<const char*>(mapped_ptr);
+			}
+#endif
+			if (!data_val) {
+				size_val = 0;
+				if constexpr (exceptions) {
+					throw std::runtime_error("Failed to map file: " + filePath.string());
+				} else {
+					std::cerr << "Failed to map file: " + filePath.string() << std::endl;
+				}
+			}
+			memory_accounting::get().add_mapped_bytes(static_cast<int64_t>(size_val));
+		}
+
+		memory_mapped_file(const memory_mapped_file&)			 = delete;
+		memory_mapped_file& operator=(const memory_mapped_file&) = delete;
+
+		const char* data() const noexcept {
+			return data_val;
+		}
+
+		size_t size() const noexcept {
+			return size_val;
+		}
+
+		~memory_mapped_file() noexcept {
+			memory_accounting::get().add_mapped_bytes(-static_cast<int64_t>(size_val));
+#if defined(RT_TM_PLATFORM_WINDOWS)
+			if (data_val) {
+				UnmapViewOfFile(data_val);
+			}
+			if (mapping_handle) {
+				CloseHandle(mapping_handle);
+			}
+			if (file_handle != INVALID_HANDLE_VALUE) {
+				CloseHandle(file_handle);
+			}
+#else
+			if (data_val) {
+				munmap(const_cast<char*>(data_val), size_val);
+			}
+#endif
+		}
+
+	  private:
+		const char* data_val{};
+		size_t size_val{};
+#if defined(RT_TM_PLATFORM_WINDOWS)
+		HANDLE file_handle{ INVALID_HANDLE_VALUE };
+		HANDLE mapping_handle{};
+#endif
+	};
+
 	template<bool exceptions> class file_saver {
 	  public:
 		file_saver(const std::filesystem::path& path, const void* data, size_t size) {
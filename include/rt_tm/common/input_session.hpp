@@ -23,3 +23,136 @@ FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TOR
 OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
 OR OTHER DEALINGS IN THE SOFTWARE.
 */
+
+#pragma once
+
+#include <rt_tm/common/memory_accounting.hpp>
+#include <rt_tm/common/kv_cache.hpp>
+#include <rt_tm/common/common.hpp>
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+namespace rt_tm {
+
+	// One conversation's view of the KV cache: a block table mapping its token positions onto blocks of the shared
+	// pool, so it only holds memory in proportion to its own context length.
+	template<global_config config> class input_session {
+	  public:
+		inline static constexpr uint64_t invalid_position{ std::numeric_limits<uint64_t>::max() };
+
+		RT_TM_INLINE input_session(kv_block_pool<config>& pool_new, uint64_t session_id_new) noexcept : pool{ &pool_new }, session_id{ session_id_new } {
+		}
+
+		input_session(const input_session&)			   = delete;
+		input_session& operator=(const input_session&) = delete;
+
+		RT_TM_INLINE ~input_session() noexcept {
+			clear();
+		}
+
+		// Reserves the KV slot of the next token and returns its position, growing the block table when the last
+		// block is full; returns invalid_position when the pool is exhausted and exceptions are disabled.
+		RT_TM_INLINE uint64_t append_token() noexcept(!config.exceptions) {
+			const uint64_t block_tokens{ pool->get_config().block_tokens };
+			if (token_count_val == block_table.size() * block_tokens) {
+				const uint32_t block{ pool->allocate_block() };
+				if (block == kv_block_pool<config>::invalid_block) {
+					return invalid_position;
+				}
+				block_table.emplace_back(block);
+				memory_accounting::get().set_kv_bytes(session_id, block_table.size() * pool->block_bytes());
+			} else if (uint32_t& block = block_table[token_count_val / block_tokens]; pool->get_ref_count(block) > 1) {
+				const uint32_t copy{ pool->copy_block(block) };
+				if (copy == kv_block_pool<config>::invalid_block) {
+					return invalid_position;
+				}
+				pool->release_block(block);
+				block = copy;
+			}
+			return token_count_val++;
+		}
+
+		// Rolls the session back to token_count tokens, e.g. to regenerate from an earlier point; the next append
+		// copies the last block first if another session or the prefix cache still shares it.
+		RT_TM_INLINE void truncate(uint64_t token_count) noexcept {
+			const uint64_t block_tokens{ pool->get_config().block_tokens };
+			token_count_val = std::min(token_count_val, token_count);
+			while (block_table.size() * block_tokens >= token_count_val + block_tokens) {
+				pool->release_block(block_table.back());
+				block_table.pop_back();
+			}
+			memory_accounting::get().set_kv_bytes(session_id, block_table.size() * pool->block_bytes());
+		}
+
+		// Starts an empty session from cached prefix blocks, taking a reference on each.
+		RT_TM_INLINE void adopt_prefix(const std::vector<uint32_t>& blocks) {
+			clear();
+			for (uint32_t block: blocks) {
+				pool->retain_block(block);
+			}
+			block_table		= blocks;
+			token_count_val = blocks.size() * pool->get_config().block_tokens;
+			memory_accounting::get().set_kv_bytes(session_id, block_table.size() * pool->block_bytes());
+		}
+
+		RT_TM_FORCE_INLINE uint8_t* get_key(uint64_t layer, uint64_t position) const noexcept {
+			const uint64_t block_tokens{ pool->get_config().block_tokens };
+			return pool->get_key(block_table[position / block_tokens], layer, position % block_tokens);
+		}
+
+		RT_TM_FORCE_INLINE uint8_t* get_value(uint64_t layer, uint64_t position) const noexcept {
+			const uint64_t block_tokens{ pool->get_config().block_tokens };
+			return pool->get_value(block_table[position / block_tokens], layer, position % block_tokens);
+		}
+
+		// Quantizes a full key or value row into the cache's storage type.
+		RT_TM_INLINE void store_key(uint64_t layer, uint64_t position, const float* key) const noexcept {
+			kv_store_row(pool->get_config().type, key, get_key(layer, position), pool->get_config().key_row_elements);
+		}
+
+		RT_TM_INLINE void store_value(uint64_t layer, uint64_t position, const float* value) const noexcept {
+			kv_store_row(pool->get_config().type, value, get_value(layer, position), pool->get_config().value_row_elements);
+		}
+
+		// query . key[element_offset, element_offset + count), for one head of a cached key row.
+		RT_TM_FORCE_INLINE float dot_key(uint64_t layer, uint64_t position, uint64_t element_offset, const float* query, uint64_t count) const noexcept {
+			return kv_dot_row(pool->get_config().type, get_key(layer, position), element_offset, query, count);
+		}
+
+		// output += weight * value[element_offset, element_offset + count), for one head of a cached value row.
+		RT_TM_FORCE_INLINE void accumulate_value(uint64_t layer, uint64_t position, uint64_t element_offset, float weight, float* output, uint64_t count) const noexcept {
+			kv_accumulate_row(pool->get_config().type, get_value(layer, position), element_offset, weight, output, count);
+		}
+
+		RT_TM_INLINE void clear() noexcept {
+			for (uint32_t block: block_table) {
+				pool->release_block(block);
+			}
+			if (!block_table.empty()) {
+				memory_accounting::get().set_kv_bytes(session_id, 0);
+			}
+			block_table.clear();
+			token_count_val = 0;
+		}
+
+		RT_TM_FORCE_INLINE const std::vector<uint32_t>& get_block_table() const noexcept {
+			return block_table;
+		}
+
+		RT_TM_FORCE_INLINE uint64_t token_count() const noexcept {
+			return token_count_val;
+		}
+
+		RT_TM_FORCE_INLINE uint64_t get_session_id() const noexcept {
+			return session_id;
+		}
+
+	  protected:
+		std::vector<uint32_t> block_table{};
+		kv_block_pool<config>* pool{};
+		uint64_t token_count_val{};
+		uint64_t session_id{};
+	};
+
+}
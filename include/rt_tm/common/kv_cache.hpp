@@ -0,0 +1,287 @@
+/*
+MIT License
+
+Copyright (c) 2025 RealTimeChris (Chris M)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "RT-TM Library"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+This file was independently created by RealTimeChris (Chris M), without reuse
+or derivation from any codebase owned by other entities, including any contract work.
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT
+OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#pragma once
+
+#include <rt_tm/common/memory_accounting.hpp>
+#include <rt_tm/common/model_graph.hpp>
+#include <rt_tm/common/quantization.hpp>
+#include <rt_tm/common/type_traits.hpp>
+#include <rt_tm/common/allocator.hpp>
+#include <rt_tm/common/common.hpp>
+#include <stdexcept>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+namespace rt_tm {
+
+	struct kv_cache_config {
+		uint64_t layer_count{};
+		uint64_t key_row_elements{};
+		uint64_t value_row_elements{};
+		uint64_t block_tokens{ 16 };
+		uint64_t max_blocks{};
+		data_type type{ data_type::float_32 };
+
+		// One row per token holds every KV head of a layer; max_tokens is shared by all sessions using the pool.
+		RT_TM_INLINE static kv_cache_config from_hparams(const hyper_parameters& hparams, uint64_t max_tokens, uint64_t block_tokens = 16,
+			data_type type = data_type::float_32) {
+			kv_cache_config return_value{};
+			const uint64_t head_count_kv{ hparams.head_count_kv ? hparams.head_count_kv : hparams.head_count };
+			const uint64_t head_dimension{ hparams.head_count ? hparams.embedding_length / hparams.head_count : 0 };
+			return_value.layer_count		= hparams.block_count;
+			return_value.key_row_elements	= head_count_kv * (hparams.key_length ? hparams.key_length : head_dimension);
+			return_value.value_row_elements = head_count_kv * (hparams.value_length ? hparams.value_length : head_dimension);
+			return_value.block_tokens		= block_tokens;
+			return_value.max_blocks			= (max_tokens + block_tokens - 1) / block_tokens;
+			return_value.type				= type;
+			return return_value;
+		}
+	};
+
+	RT_TM_FORCE_INLINE constexpr bool is_kv_type_supported(data_type type) noexcept {
+		return type == data_type::float_32 || type == data_type::q8_0 || type == data_type::q4_0;
+	}
+
+	// Writes count elements into a KV row, quantizing them on the way in.
+	RT_TM_INLINE void kv_store_row(data_type type, const float* input, void* output, uint64_t count) noexcept {
+		switch (type) {
+			case data_type::q8_0: {
+				quantize_row_q8_0(input, static_cast<block_q8_0*>(output), count);
+				break;
+			}
+			case data_type::q4_0: {
+				quantize_row_q4_0(input, static_cast<block_q4_0*>(output), count);
+				break;
+			}
+			default: {
+				std::memcpy(output, input, count * sizeof(float));
+				break;
+			}
+		}
+	}
+
+	// Dot product of query with elements [element_offset, element_offset + count) of a KV row, dequantizing one block
+	// at a time; element_offset and count must be multiples of the type's block size.
+	RT_TM_INLINE float kv_dot_row(data_type type, const void* row, uint64_t element_offset, const float* query, uint64_t count) noexcept {
+		const uint8_t* data{ static_cast<const uint8_t*>(row) + get_row_size(type, element_offset) };
+		float return_value{};
+		switch (type) {
+			case data_type::q8_0: {
+				const block_q8_0* blocks{ reinterpret_cast<const block_q8_0*>(data) };
+				for (uint64_t block = 0; block < count / q8_0_block_size; ++block) {
+					const float* values{ query + block * q8_0_block_size };
+					float sum{};
+					for (uint64_t x = 0; x < q8_0_block_size; ++x) {
+						sum += static_cast<float>(blocks[block].quants[x]) * values[x];
+					}
+					return_value += fp16_to_fp32(blocks[block].scale) * sum;
+				}
+				break;
+			}
+			case data_type::q4_0: {
+				const block_q4_0* blocks{ reinterpret_cast<const block_q4_0*>(data) };
+				for (uint64_t block = 0; block < count / q4_0_block_size; ++block) {
+					const float* values{ query + block * q4_0_block_size };
+					float sum{};
+					for (uint64_t x = 0; x < q4_0_block_size / 2; ++x) {
+						sum += static_cast<float>((blocks[block].quants[x] & 0x0F) - 8) * values[x];
+						sum += static_cast<float>((blocks[block].quants[x] >> 4) - 8) * values[x + q4_0_block_size / 2];
+					}
+					return_value += fp16_to_fp32(blocks[block].scale) * sum;
+				}
+				break;
+			}
+			default: {
+				const float* values{ reinterpret_cast<const float*>(data) };
+				for (uint64_t x = 0; x < count; ++x) {
+					return_value += values[x] * query[x];
+				}
+				break;
+			}
+		}
+		return return_value;
+	}
+
+	// output += weight * row[element_offset, element_offset + count), dequantizing one block at a time.
+	RT_TM_INLINE void kv_accumulate_row(data_type type, const void* row, uint64_t element_offset, float weight, float* output, uint64_t count) noexcept {
+		const uint8_t* data{ static_cast<const uint8_t*>(row) + get_row_size(type, element_offset) };
+		switch (type) {
+			case data_type::q8_0: {
+				const block_q8_0* blocks{ reinterpret_cast<const block_q8_0*>(data) };
+				for (uint64_t block = 0; block < count / q8_0_block_size; ++block) {
+					const float scale{ weight * fp16_to_fp32(blocks[block].scale) };
+					float* values{ output + block * q8_0_block_size };
+					for (uint64_t x = 0; x < q8_0_block_size; ++x) {
+						values[x] += scale * static_cast<float>(blocks[block].quants[x]);
+					}
+				}
+				break;
+			}
+			case data_type::q4_0: {
+				const block_q4_0* blocks{ reinterpret_cast<const block_q4_0*>(data) };
+				for (uint64_t block = 0; block < count / q4_0_block_size; ++block) {
+					const float scale{ weight * fp16_to_fp32(blocks[block].scale) };
+					float* values{ output + block * q4_0_block_size };
+					for (uint64_t x = 0; x < q4_0_block_size / 2; ++x) {
+						values[x] += scale * static_cast<float>((blocks[block].quants[x] & 0x0F) - 8);
+						values[x + q4_0_block_size / 2] += scale * static_cast<float>((blocks[block].quants[x] >> 4) - 8);
+					}
+				}
+				break;
+			}
+			default: {
+				const float* values{ reinterpret_cast<const float*>(data) };
+				for (uint64_t x = 0; x < count; ++x) {
+					output[x] += weight * values[x];
+				}
+				break;
+			}
+		}
+	}
+
+	// Fixed-size token blocks shared by every session. The whole pool is reserved up front as untouched anonymous
+	// pages, so physical memory is only committed as blocks are first written. A block stores, for each layer,
+	// block_tokens key rows followed by block_tokens value rows.
+	template<global_config config> class kv_block_pool {
+	  public:
+		inline static constexpr uint32_t invalid_block{ std::numeric_limits<uint32_t>::max() };
+		inline static constexpr uint64_t block_alignment{ 64 };
+
+		RT_TM_INLINE kv_block_pool(const kv_cache_config& config_new) : config_val{ config_new } {
+			const uint64_t block_size{ get_data_type_traits(config_val.type).block_size };
+			if (!is_kv_type_supported(config_val.type) || config_val.key_row_elements % block_size != 0 || config_val.value_row_elements % block_size != 0) {
+				throw std::runtime_error{ "Sorry, but the KV cache only stores float_32, q8_0 and q4_0 rows of whole blocks!" };
+			}
+			key_row_bytes	  = get_row_size(config_val.type, config_val.key_row_elements);
+			value_row_bytes	  = get_row_size(config_val.type, config_val.value_row_elements);
+			key_block_bytes	  = roundUpToMultiple<uint64_t>(key_row_bytes * config_val.block_tokens, block_alignment);
+			value_block_bytes = roundUpToMultiple<uint64_t>(value_row_bytes * config_val.block_tokens, block_alignment);
+			block_bytes_val	  = (key_block_bytes + value_block_bytes) * config_val.layer_count;
+			data_val		  = alloc_wrapper<uint8_t>::allocate_pages(block_bytes_val * config_val.max_blocks);
+			if (!data_val && block_bytes_val * config_val.max_blocks > 0) {
+				if constexpr (config.exceptions) {
+					throw std::runtime_error{ "Sorry, but the KV block pool could not be reserved!" };
+				} else {
+					std::cerr << "Sorry, but the KV block pool could not be reserved!" << std::endl;
+					return;
+				}
+			}
+			ref_counts = std::make_unique<std::atomic<uint32_t>[]>(config_val.max_blocks);
+			free_blocks.reserve(config_val.max_blocks);
+			for (uint64_t x = config_val.max_blocks; x > 0; --x) {
+				free_blocks.emplace_back(static_cast<uint32_t>(x - 1));
+			}
+		}
+
+		kv_block_pool(const kv_block_pool&)			   = delete;
+		kv_block_pool& operator=(const kv_block_pool&) = delete;
+
+		RT_TM_INLINE ~kv_block_pool() noexcept {
+			alloc_wrapper<uint8_t>::deallocate_pages(data_val, block_bytes_val * config_val.max_blocks);
+		}
+
+		RT_TM_INLINE uint32_t allocate_block() noexcept(!config.exceptions) {
+			std::unique_lock lock{ mutex };
+			if (free_blocks.empty()) {
+				if constexpr (config.exceptions) {
+					throw std::runtime_error{ "Sorry, but the KV block pool is out of blocks!" };
+				} else {
+					return invalid_block;
+				}
+			}
+			const uint32_t return_value{ free_blocks.back() };
+			free_blocks.pop_back();
+			ref_counts[return_value].store(1, std::memory_order_relaxed);
+			return return_value;
+		}
+
+		// Blocks are reference counted so sessions and the prefix cache can share them; the last release frees it.
+		// The counts are atomic, so only allocation and the final release take the pool's mutex, and the per-token
+		// sharing check in input_session::append_token is a plain load.
+		RT_TM_FORCE_INLINE void retain_block(uint32_t block) noexcept {
+			ref_counts[block].fetch_add(1, std::memory_order_relaxed);
+		}
+
+		RT_TM_INLINE void release_block(uint32_t block) {
+			if (ref_counts[block].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+				std::unique_lock lock{ mutex };
+				free_blocks.emplace_back(block);
+			}
+		}
+
+		RT_TM_FORCE_INLINE uint32_t get_ref_count(uint32_t block) const noexcept {
+			return ref_counts[block].load(std::memory_order_acquire);
+		}
+
+		// Allocates a private duplicate of block for a writer that must not disturb the other holders.
+		RT_TM_INLINE uint32_t copy_block(uint32_t block) noexcept(!config.exceptions) {
+			const uint32_t return_value{ allocate_block() };
+			if (return_value != invalid_block) {
+				std::memcpy(data_val + return_value * block_bytes_val, data_val + block * block_bytes_val, block_bytes_val);
+			}
+			return return_value;
+		}
+
+		RT_TM_FORCE_INLINE uint8_t* get_key(uint32_t block, uint64_t layer, uint64_t slot) const noexcept {
+			return data_val + block * block_bytes_val + layer * (key_block_bytes + value_block_bytes) + slot * key_row_bytes;
+		}
+
+		RT_TM_FORCE_INLINE uint8_t* get_value(uint32_t block, uint64_t layer, uint64_t slot) const noexcept {
+			return data_val + block * block_bytes_val + layer * (key_block_bytes + value_block_bytes) + key_block_bytes + slot * value_row_bytes;
+		}
+
+		RT_TM_FORCE_INLINE const kv_cache_config& get_config() const noexcept {
+			return config_val;
+		}
+
+		RT_TM_FORCE_INLINE uint64_t block_bytes() const noexcept {
+			return block_bytes_val;
+		}
+
+		RT_TM_INLINE size_t free_block_count() const {
+			std::unique_lock lock{ mutex };
+			return free_blocks.size();
+		}
+
+	  protected:
+		std::vector<uint32_t> free_blocks{};
+		std::unique_ptr<std::atomic<uint32_t>[]> ref_counts{};
+		kv_cache_config config_val{};
+		mutable std::mutex mutex{};
+		uint64_t value_block_bytes{};
+		uint64_t key_block_bytes{};
+		uint64_t value_row_bytes{};
+		uint64_t key_row_bytes{};
+		uint64_t block_bytes_val{};
+		uint8_t* data_val{};
+	};
+
+}
@@ -0,0 +1,161 @@
+/*
+MIT License
+
+Copyright (c) 2025 RealTimeChris (Chris M)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "RT-TM Library"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+This file was independently created by RealTimeChris (Chris M), without reuse
+or derivation from any codebase owned by other entities, including any contract work.
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT
+OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#pragma once
+
+#include <rt_tm/common/config.hpp>
+#include <algorithm>
+#include <fstream>
+#include <atomic>
+#include <mutex>
+#include <map>
+#include <vector>
+
+#if defined(RT_TM_PLATFORM_WINDOWS)
+	#if !defined(NOMINMAX)
+		#define NOMINMAX
+	#endif
+	#if !defined(WIN32_LEAN_AND_MEAN)
+		#define WIN32_LEAN_AND_MEAN
+	#endif
+	#include <windows.h>
+	#include <psapi.h>
+#else
+	#include <sys/mman.h>
+	#include <unistd.h>
+#endif
+
+namespace rt_tm {
+
+	struct session_memory {
+		uint64_t session_id{};
+		uint64_t kv_bytes{};
+	};
+
+	struct memory_snapshot {
+		std::vector<session_memory> sessions{};
+		uint64_t mapped_bytes{};
+		uint64_t resident_bytes{};
+		uint64_t buffer_bytes{};
+		uint64_t buffer_peak_bytes{};
+		uint64_t kv_bytes{};
+	};
+
+	// Bytes of [ptr, ptr + size) currently resident in RAM, from mincore.
+	RT_TM_INLINE uint64_t get_resident_bytes(const void* ptr, size_t size) {
+#if defined(RT_TM_PLATFORM_WINDOWS)
+		static_cast<void>(ptr);
+		static_cast<void>(size);
+		return 0;
+#else
+		if (!ptr || size == 0) {
+			return 0;
+		}
+		const size_t page_size{ static_cast<size_t>(sysconf(_SC_PAGESIZE)) };
+		const uintptr_t begin{ reinterpret_cast<uintptr_t>(ptr) & ~(page_size - 1) };
+		const size_t length{ reinterpret_cast<uintptr_t>(ptr) + size - begin };
+	#if defined(RT_TM_PLATFORM_MAC)
+		std::vector<char> pages((length + page_size - 1) / page_size);
+		if (mincore(reinterpret_cast<caddr_t>(begin), length, pages.data()) != 0) {
+	#else
+		std::vector<unsigned char> pages((length + page_size - 1) / page_size);
+		if (mincore(reinterpret_cast<void*>(begin), length, pages.data()) != 0) {
+	#endif
+			return 0;
+		}
+		return static_cast<uint64_t>(std::count_if(pages.begin(), pages.end(), [](auto page) {
+			return (page & 1) != 0;
+		})) * page_size;
+#endif
+	}
+
+	// Resident set size of the whole process.
+	RT_TM_INLINE uint64_t get_process_resident_bytes() {
+#if defined(RT_TM_PLATFORM_WINDOWS)
+		PROCESS_MEMORY_COUNTERS counters{};
+		return GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)) ? static_cast<uint64_t>(counters.WorkingSetSize) : 0;
+#elif defined(RT_TM_PLATFORM_LINUX)
+		std::ifstream statm{ "/proc/self/statm" };
+		uint64_t total_pages{};
+		uint64_t resident_pages{};
+		statm >> total_pages >> resident_pages;
+		return resident_pages * static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+#else
+		return 0;
+#endif
+	}
+
+	// Process-wide counters fed by memory_mapped_file, alloc_wrapper's page allocations, memory_buffer and the KV
+	// cache; snapshot() can be called at any time from any thread.
+	class memory_accounting {
+	  public:
+		RT_TM_FORCE_INLINE static memory_accounting& get() noexcept {
+			static memory_accounting accounting{};
+			return accounting;
+		}
+
+		RT_TM_FORCE_INLINE void add_mapped_bytes(int64_t byte_count) noexcept {
+			mapped_bytes.fetch_add(static_cast<uint64_t>(byte_count), std::memory_order_relaxed);
+		}
+
+		RT_TM_FORCE_INLINE void add_buffer_bytes(int64_t byte_count) noexcept {
+			const uint64_t current{ buffer_bytes.fetch_add(static_cast<uint64_t>(byte_count), std::memory_order_relaxed) + static_cast<uint64_t>(byte_count) };
+			uint64_t peak{ buffer_peak_bytes.load(std::memory_order_relaxed) };
+			while (current > peak && !buffer_peak_bytes.compare_exchange_weak(peak, current, std::memory_order_relaxed)) {
+			}
+		}
+
+		RT_TM_INLINE void set_kv_bytes(uint64_t session_id, uint64_t byte_count) {
+			std::unique_lock lock{ mutex };
+			if (byte_count == 0) {
+				kv_bytes.erase(session_id);
+			} else {
+				kv_bytes[session_id] = byte_count;
+			}
+		}
+
+		RT_TM_INLINE memory_snapshot snapshot() const {
+			memory_snapshot return_value{};
+			return_value.mapped_bytes	   = mapped_bytes.load(std::memory_order_relaxed);
+			return_value.buffer_bytes	   = buffer_bytes.load(std::memory_order_relaxed);
+			return_value.buffer_peak_bytes = buffer_peak_bytes.load(std::memory_order_relaxed);
+			return_value.resident_bytes	   = get_process_resident_bytes();
+			std::unique_lock lock{ mutex };
+			for (auto& [session_id, byte_count]: kv_bytes) {
+				return_value.sessions.emplace_back(session_memory{ session_id, byte_count });
+				return_value.kv_bytes += byte_count;
+			}
+			return return_value;
+		}
+
+	  protected:
+		std::map<uint64_t, uint64_t> kv_bytes{};
+		std::atomic<uint64_t> mapped_bytes{};
+		std::atomic<uint64_t> buffer_bytes{};
+		std::atomic<uint64_t> buffer_peak_bytes{};
+		mutable std::mutex mutex{};
+	};
+
+}
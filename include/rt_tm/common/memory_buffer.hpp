@@ -25,26 +25,51 @@ OR OTHER DEALINGS IN THE SOFTWARE.
 */
 #pragma once
 
+#include <rt_tm/common/allocation_policy.hpp>
+#include <rt_tm/common/memory_accounting.hpp>
 #include <rt_tm/common/allocator.hpp>
 #include <rt_tm/common/common.hpp>
 #include <rt_tm/common/config.hpp>
 #include <stdexcept>
+#include <algorithm>
 #include <iterator>
+#include <atomic>
 
 namespace rt_tm {
 
-	template<global_config config, typename value_type_new> struct memory_buffer : public alloc_wrapper<value_type_new> {
+	template<global_config config, typename value_type_new> struct memory_buffer : public alloc_wrapper<value_type_new, config_allocation_policy<config>> {
 		using value_type = value_type_new;
-		using alloc		 = alloc_wrapper<value_type>;
+		using alloc		 = alloc_wrapper<value_type, config_allocation_policy<config>>;
 		using pointer	 = value_type*;
 		using size_type	 = size_t;
 
-		RT_TM_FORCE_INLINE memory_buffer(size_t size) noexcept {
-			data_val = alloc::allocate(size);
-			size_val = size;
+		// Rewinds the buffer to the offset it had when the marker was taken, releasing every claim made since.
+		struct scope_marker {
+			RT_TM_FORCE_INLINE scope_marker(memory_buffer& buffer_new) noexcept : buffer{ buffer_new }, offset{ buffer_new.current_offset } {
+			}
+
+			scope_marker(const scope_marker&)			 = delete;
+			scope_marker& operator=(const scope_marker&) = delete;
+
+			RT_TM_FORCE_INLINE ~scope_marker() noexcept {
+				buffer.current_offset = offset;
+			}
+
+		  protected:
+			memory_buffer& buffer;
+			size_type offset{};
+		};
+
+		RT_TM_FORCE_INLINE memory_buffer(size_t size, std::source_location location = std::source_location::current()) noexcept {
+			data_val = alloc::allocate(size, location);
+			size_val = data_val ? size : 0;
+			memory_accounting::get().add_buffer_bytes(static_cast<int64_t>(size_val * sizeof(value_type)));
 		}
 
-		RT_TM_FORCE_INLINE pointer claim_memory(size_t amount_to_claim) noexcept {
+		memory_buffer(const memory_buffer&)			   = delete;
+		memory_buffer& operator=(const memory_buffer&) = delete;
+
+		RT_TM_FORCE_INLINE pointer claim_memory(size_t amount_to_claim) noexcept(!config.exceptions) {
 			if (current_offset + amount_to_claim > size_val) {
 				if constexpr (config.exceptions) {
 					throw std::runtime_error{ "Sorry, but this memory_buffer is out of memory!" };
@@ -54,20 +79,143 @@ namespace rt_tm {
 			}
 			pointer return_value = data_val + current_offset;
 			current_offset += amount_to_claim;
+			peak_offset = std::max(peak_offset, current_offset);
 			return return_value;
 		}
 
+		// Pads the current offset so the returned address is a multiple of alignment bytes (e.g. 64 or 4096).
+		RT_TM_FORCE_INLINE pointer claim_memory(size_t amount_to_claim, size_t alignment) noexcept(!config.exceptions) {
+			const uintptr_t address{ reinterpret_cast<uintptr_t>(data_val + current_offset) };
+			const size_t padding_bytes{ roundUpToMultiple<uintptr_t>(address, alignment) - address };
+			const size_type padding{ (padding_bytes + sizeof(value_type) - 1) / sizeof(value_type) };
+			if (current_offset + padding + amount_to_claim > size_val) {
+				if constexpr (config.exceptions) {
+					throw std::runtime_error{ "Sorry, but this memory_buffer is out of memory!" };
+				} else {
+					return nullptr;
+				}
+			}
+			current_offset += padding;
+			return claim_memory(amount_to_claim);
+		}
+
+		[[nodiscard]] RT_TM_FORCE_INLINE scope_marker mark() noexcept {
+			return scope_marker{ *this };
+		}
+
+		RT_TM_FORCE_INLINE void reset() noexcept {
+			current_offset = 0;
+		}
+
+		RT_TM_FORCE_INLINE size_type used() const noexcept {
+			return current_offset;
+		}
+
+		RT_TM_FORCE_INLINE size_type size() const noexcept {
+			return size_val;
+		}
+
+		RT_TM_FORCE_INLINE pointer data() const noexcept {
+			return data_val;
+		}
+
+		// The largest offset reached since construction, across every reset and rewind.
+		RT_TM_FORCE_INLINE size_type high_water() const noexcept {
+			return peak_offset;
+		}
+
 		RT_TM_FORCE_INLINE ~memory_buffer() noexcept {
 			if (data_val && size_val > 0) {
-				alloc::deallocate(data_val);
+				memory_accounting::get().add_buffer_bytes(-static_cast<int64_t>(size_val * sizeof(value_type)));
+				alloc::deallocate(data_val, size_val);
 				data_val = nullptr;
 			}
 		}
 
 	  protected:
 		size_type current_offset{};
+		size_type peak_offset{};
 		value_type* data_val{};
 		size_type size_val{};
 	};
 
+	// A memory_buffer that any number of threads may claim from at once: the bump pointer is a single atomic advanced
+	// with fetch_add, kept on its own cache line. A claim that does not fit fails per config.exceptions and leaves
+	// the buffer exhausted until reset().
+	template<global_config config, typename value_type_new> struct concurrent_memory_buffer : public alloc_wrapper<value_type_new, config_allocation_policy<config>> {
+		using value_type = value_type_new;
+		using alloc		 = alloc_wrapper<value_type, config_allocation_policy<config>>;
+		using pointer	 = value_type*;
+		using size_type	 = size_t;
+
+		RT_TM_FORCE_INLINE concurrent_memory_buffer(size_t size, std::source_location location = std::source_location::current()) noexcept {
+			data_val = alloc::allocate(size, location);
+			size_val = data_val ? size : 0;
+			memory_accounting::get().add_buffer_bytes(static_cast<int64_t>(size_val * sizeof(value_type)));
+		}
+
+		concurrent_memory_buffer(const concurrent_memory_buffer&)			 = delete;
+		concurrent_memory_buffer& operator=(const concurrent_memory_buffer&) = delete;
+
+		RT_TM_FORCE_INLINE pointer claim_memory(size_t amount_to_claim) noexcept(!config.exceptions) {
+			const size_type offset{ current_offset.fetch_add(amount_to_claim, std::memory_order_relaxed) };
+			if (offset + amount_to_claim > size_val) {
+				return out_of_memory();
+			}
+			return data_val + offset;
+		}
+
+		// Aligned claims cannot be a single fetch_add, so they retry a compare-exchange with the padded offset.
+		RT_TM_FORCE_INLINE pointer claim_memory(size_t amount_to_claim, size_t alignment) noexcept(!config.exceptions) {
+			size_type offset{ current_offset.load(std::memory_order_relaxed) };
+			size_type aligned_offset{};
+			do {
+				const uintptr_t address{ reinterpret_cast<uintptr_t>(data_val + offset) };
+				aligned_offset = offset + (roundUpToMultiple<uintptr_t>(address, alignment) - address + sizeof(value_type) - 1) / sizeof(value_type);
+				if (aligned_offset + amount_to_claim > size_val) {
+					return out_of_memory();
+				}
+			} while (!current_offset.compare_exchange_weak(offset, aligned_offset + amount_to_claim, std::memory_order_relaxed));
+			return data_val + aligned_offset;
+		}
+
+		// Not safe to call while other threads are claiming.
+		RT_TM_FORCE_INLINE void reset() noexcept {
+			current_offset.store(0, std::memory_order_relaxed);
+		}
+
+		RT_TM_FORCE_INLINE size_type used() const noexcept {
+			return std::min(current_offset.load(std::memory_order_relaxed), size_val);
+		}
+
+		RT_TM_FORCE_INLINE size_type size() const noexcept {
+			return size_val;
+		}
+
+		RT_TM_FORCE_INLINE pointer data() const noexcept {
+			return data_val;
+		}
+
+		RT_TM_FORCE_INLINE ~concurrent_memory_buffer() noexcept {
+			if (data_val && size_val > 0) {
+				memory_accounting::get().add_buffer_bytes(-static_cast<int64_t>(size_val * sizeof(value_type)));
+				alloc::deallocate(data_val, size_val);
+				data_val = nullptr;
+			}
+		}
+
+	  protected:
+		alignas(64) std::atomic<size_type> current_offset{};
+		alignas(64) value_type* data_val{};
+		size_type size_val{};
+
+		RT_TM_FORCE_INLINE pointer out_of_memory() const noexcept(!config.exceptions) {
+			if constexpr (config.exceptions) {
+				throw std::runtime_error{ "Sorry, but this memory_buffer is out of memory!" };
+			} else {
+				return nullptr;
+			}
+		}
+	};
+
 }
@@ -25,10 +25,26 @@ OR OTHER DEALINGS IN THE SOFTWARE.
 */
 #pragma once
 
+#include <rt_tm/common/type_traits.hpp>
 #include <rt_tm/common/common.hpp>
+#include <rt_tm/common/array.hpp>
+#include <string_view>
 
 namespace rt_tm {
 
-	struct model_core {};
+	inline static constexpr size_t max_tensor_dimensions{ 4 };
+
+	// Non-owning view of a single weight tensor; data points into the model file that model_graph keeps alive.
+	struct model_core {
+		array<uint64_t, max_tensor_dimensions> dimensions{ 1, 1, 1, 1 };
+		array<uint64_t, max_tensor_dimensions> strides{};
+		std::string_view name{};
+		const void* data{};
+		uint64_t byte_size{};
+		uint32_t n_dimensions{};
+		data_type type{};
+		// Rows per interleaved tile once a weight_cache has repacked the tensor; 1 is the plain GGUF row-major layout.
+		uint32_t interleaved_rows{ 1 };
+	};
 
 }
\ No newline at end of file
@@ -26,14 +26,27 @@ OR OTHER DEALINGS IN THE SOFTWARE.
 #pragma once
 
 #include <rt_tm/common/model_core.hpp>
+#include <rt_tm/common/string_pool.hpp>
+#include <rt_tm/common/telemetry.hpp>
+#include <rt_tm/common/allocator.hpp>
+#include <rt_tm/common/numa.hpp>
+#include <rt_tm/common/memory_accounting.hpp>
 #include <rt_tm/common/common.hpp>
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <vector>
+#include <string>
+#include <memory>
+#include <thread>
+#include <atomic>
 
 namespace rt_tm {
 
 	struct tokenizer_parameters {
 		std::vector<int64_t> token_types{};
-		std::vector<std::string> tokens{};
-		std::vector<std::string> merges{};
+		string_pool tokens{};
+		string_pool merges{};
 		std::string chat_template{};
 		uint64_t bos_token_id{};
 		uint64_t eos_token_id{};
@@ -41,27 +54,305 @@ namespace rt_tm {
 	};
 
 	struct hyper_parameters {
+		uint64_t rope_scaling_original_context_length{};
 		uint64_t imatrix_entries_count{};
 		uint64_t imatrix_chunks_count{};
 		uint64_t quantization_version{};
 		uint64_t rope_dimension_count{};
+		std::string rope_scaling_type{};
 		uint64_t feed_forward_length{};
+		uint64_t expert_used_count{};
 		uint64_t embedding_length{};
+		float rope_scaling_factor{};
 		std::string imatrix_file{};
+		std::string architecture{};
 		uint64_t context_length{};
+		uint64_t sliding_window{};
 		uint64_t head_count_kv{};
 		float rms_norm_epsilon{};
+		uint64_t expert_count{};
+		uint64_t value_length{};
 		uint64_t block_count{};
 		float rope_freq_base{};
 		uint64_t head_count{};
 		uint64_t vocab_size{};
+		uint64_t key_length{};
 		uint64_t file_type{};
 	};
 
+	// Position of a tensor in forward-pass order: token_embd first, then blk.N in order, then everything else.
+	RT_TM_FORCE_INLINE uint64_t get_execution_order(std::string_view name) noexcept {
+		if (name.starts_with("token_embd")) {
+			return 0;
+		}
+		if (name.starts_with("blk.")) {
+			uint64_t layer_index{};
+			if (std::from_chars(name.data() + 4, name.data() + name.size(), layer_index).ec == std::errc{}) {
+				return layer_index + 1;
+			}
+		}
+		return std::numeric_limits<uint64_t>::max();
+	}
+
+	// Where one tensor lives under NUMA placement: small tensors get a replica per node, larger ones are split by rows
+	// and node n owns rows [row_splits[n], row_splits[n + 1]).
+	struct numa_tensor_placement {
+		std::vector<const void*> replicas{};
+		std::vector<uint64_t> row_splits{};
+	};
+
 	struct model_graph {
+		inline static constexpr uint64_t numa_replicate_bytes{ 256 * 1024 };
+		inline static constexpr uint64_t warm_up_chunk_bytes{ 4 * 1024 * 1024 };
+
 		tokenizer_parameters tokenizer_params{};
 		std::vector<model_core> model_cores{};
+		std::shared_ptr<const void> resident_handle{};
+		std::vector<std::shared_ptr<const void>> file_handles{};
+		residency_telemetry residency{};
+		load_telemetry telemetry{};
 		hyper_parameters hparams{};
+		uint64_t model_hash{};
+		std::vector<numa_tensor_placement> numa_placements{};
+		std::shared_ptr<const void> numa_handle{};
+		numa_telemetry numa{};
+
+		// Keeps the weights in RAM: either pins the mapped pages with mlock/VirtualLock, or copies every tensor
+		// into one huge-page-backed region and rebinds the views to it.
+		RT_TM_INLINE residency_telemetry make_resident(residency_mode mode) {
+			residency_telemetry return_value{};
+			switch (mode) {
+				case residency_mode::locked: {
+					const size_t page_size{ get_page_size() };
+					const size_t chunk_size{ page_size * 512 };
+					return_value.page_size = page_size;
+					// Adjacent tensors can share a page, so the page ranges are merged before locking and counting.
+					std::vector<std::pair<uintptr_t, uintptr_t>> page_ranges{};
+					page_ranges.reserve(model_cores.size());
+					for (auto& core: model_cores) {
+						return_value.bytes += core.byte_size;
+						if (core.byte_size > 0) {
+							page_ranges.emplace_back(reinterpret_cast<uintptr_t>(core.data) & ~(page_size - 1),
+								roundUpToMultiple<uintptr_t>(reinterpret_cast<uintptr_t>(core.data) + core.byte_size, page_size));
+						}
+					}
+					std::sort(page_ranges.begin(), page_ranges.end());
+					size_t merged_count{};
+					for (auto& range: page_ranges) {
+						if (merged_count > 0 && range.first <= page_ranges[merged_count - 1].second) {
+							page_ranges[merged_count - 1].second = std::max(page_ranges[merged_count - 1].second, range.second);
+						} else {
+							page_ranges[merged_count++] = range;
+						}
+					}
+					page_ranges.resize(merged_count);
+					for (auto& [begin, end]: page_ranges) {
+						for (uintptr_t chunk = begin; chunk < end; chunk += chunk_size) {
+							const size_t length{ std::min<size_t>(chunk_size, end - chunk) };
+							return_value.pages_requested += length / page_size;
+							if (lock_pages(reinterpret_cast<const void*>(chunk), length)) {
+								return_value.pages_succeeded += length / page_size;
+							}
+						}
+					}
+					break;
+				}
+				case residency_mode::huge_pages: {
+					using allocator = alloc_wrapper<uint8_t>;
+					static constexpr size_t tensor_alignment{ 64 };
+					size_t byte_count{};
+					for (auto& core: model_cores) {
+						byte_count += roundUpToMultiple<size_t>(core.byte_size, tensor_alignment);
+					}
+					return_value.page_size		 = allocator::huge_page_size;
+					return_value.bytes			 = byte_count;
+					return_value.pages_requested = roundUpToMultiple(byte_count, allocator::huge_page_size) / allocator::huge_page_size;
+					bool explicit_huge_pages{};
+					uint8_t* data{ allocator::allocate_huge_pages(byte_count, explicit_huge_pages) };
+					if (!data) {
+						break;
+					}
+					std::shared_ptr<const void> handle{ data, [byte_count](const void* ptr) {
+														   allocator::deallocate_huge_pages(static_cast<uint8_t*>(const_cast<void*>(ptr)), byte_count);
+													   } };
+					size_t offset{};
+					for (auto& core: model_cores) {
+						std::memcpy(data + offset, core.data, core.byte_size);
+						core.data = data + offset;
+						offset += roundUpToMultiple<size_t>(core.byte_size, tensor_alignment);
+					}
+					// The views may still point into a previous resident region, so it is only released once the copy is done.
+					resident_handle = std::move(handle);
+					return_value.pages_succeeded = explicit_huge_pages ? return_value.pages_requested : get_huge_page_bytes(data) / allocator::huge_page_size;
+					break;
+				}
+				default: {
+					break;
+				}
+			}
+			return return_value;
+		}
+
+		// Copies the weights into anonymous memory laid out per node: each row slice is bound to the node whose workers
+		// consume it, tensors up to replicate_bytes are replicated on every node, and the copies are made by threads
+		// pinned to the destination node so first touch agrees with the binding.
+		RT_TM_INLINE numa_telemetry place_numa(const numa_topology& topology, uint64_t replicate_bytes = numa_replicate_bytes) {
+			using allocator = alloc_wrapper<uint8_t>;
+			struct copy_job {
+				const uint8_t* source{};
+				uint8_t* destination{};
+				uint64_t size{};
+			};
+			numa_telemetry return_value{};
+			const size_t node_count{ std::max<size_t>(topology.size(), 1) };
+			const size_t page_size{ get_page_size() };
+			return_value.node_count = node_count;
+			std::vector<uint64_t> offsets(model_cores.size());
+			size_t byte_count{};
+			for (size_t x = 0; x < model_cores.size(); ++x) {
+				offsets[x] = byte_count;
+				byte_count += roundUpToMultiple<size_t>(model_cores[x].byte_size, page_size) * (model_cores[x].byte_size <= replicate_bytes ? node_count : 1);
+			}
+			uint8_t* data{ allocator::allocate_pages(byte_count) };
+			if (!data) {
+				return return_value;
+			}
+			numa_handle = std::shared_ptr<const void>{ data, [byte_count](const void* ptr) {
+														  allocator::deallocate_pages(static_cast<uint8_t*>(const_cast<void*>(ptr)), byte_count);
+													  } };
+			const auto bind = [&](uint8_t* ptr, uint64_t size, size_t node) {
+				const uint64_t pages{ (roundUpToMultiple<uintptr_t>(reinterpret_cast<uintptr_t>(ptr) + size, page_size) - (reinterpret_cast<uintptr_t>(ptr) & ~(page_size - 1))) /
+					page_size };
+				return_value.pages_requested += pages;
+				if (bind_pages_to_node(topology, ptr, size, node)) {
+					return_value.pages_bound += pages;
+				}
+			};
+			std::vector<std::vector<copy_job>> node_jobs(node_count);
+			numa_placements.assign(model_cores.size(), numa_tensor_placement{});
+			for (size_t x = 0; x < model_cores.size(); ++x) {
+				model_core& core{ model_cores[x] };
+				numa_tensor_placement& placement{ numa_placements[x] };
+				const uint8_t* source{ static_cast<const uint8_t*>(core.data) };
+				uint8_t* destination{ data + offsets[x] };
+				if (core.byte_size == 0) {
+					continue;
+				}
+				if (core.byte_size <= replicate_bytes) {
+					for (size_t node = 0; node < node_count; ++node) {
+						uint8_t* replica{ destination + node * roundUpToMultiple<size_t>(core.byte_size, page_size) };
+						bind(replica, core.byte_size, node);
+						node_jobs[node].emplace_back(copy_job{ source, replica, core.byte_size });
+						placement.replicas.emplace_back(replica);
+					}
+					return_value.bytes_replicated += core.byte_size * node_count;
+				} else {
+					const uint64_t row_size{ core.strides[1] };
+					const uint64_t row_count{ core.byte_size / row_size };
+					for (size_t node = 0; node <= node_count; ++node) {
+						placement.row_splits.emplace_back(row_count * node / node_count / core.interleaved_rows * core.interleaved_rows);
+					}
+					for (size_t node = 0; node < node_count; ++node) {
+						const uint64_t begin{ placement.row_splits[node] * row_size };
+						const uint64_t end{ node + 1 == node_count ? core.byte_size : placement.row_splits[node + 1] * row_size };
+						if (end > begin) {
+							bind(destination + begin, end - begin, node);
+							node_jobs[node].emplace_back(copy_job{ source + begin, destination + begin, end - begin });
+						}
+					}
+					return_value.bytes_split += core.byte_size;
+				}
+				core.data = destination;
+			}
+			std::vector<std::thread> threads{};
+			threads.reserve(node_count);
+			for (size_t node = 0; node < node_count; ++node) {
+				threads.emplace_back([&topology, &jobs = node_jobs[node], node] {
+					if (node < topology.size()) {
+						pin_thread_to_cpus(topology.nodes[node].cpus, topology.simulated);
+					}
+					for (auto& job: jobs) {
+						std::memcpy(job.destination, job.source, job.size);
+					}
+				});
+			}
+			for (auto& thread: threads) {
+				thread.join();
+			}
+			return return_value;
+		}
+
+		// The copy of tensor_index that workers on node should read: their replica, or the shared split tensor.
+		RT_TM_FORCE_INLINE const void* get_node_data(size_t tensor_index, size_t node) const noexcept {
+			if (tensor_index < numa_placements.size() && node < numa_placements[tensor_index].replicas.size()) {
+				return numa_placements[tensor_index].replicas[node];
+			}
+			return model_cores[tensor_index].data;
+		}
+
+		// Bytes of tensor data currently resident in RAM; pages not yet faulted in or evicted from the mapping do not count.
+		RT_TM_INLINE uint64_t get_resident_weight_bytes() const {
+			uint64_t return_value{};
+			for (auto& core: model_cores) {
+				return_value += std::min<uint64_t>(get_resident_bytes(core.data, core.byte_size), core.byte_size);
+			}
+			return return_value;
+		}
+
+		// Faults every weight page in across thread_count threads. The tensors are cut into warm_up_chunk_bytes chunks in
+		// layer execution order and the threads claim them from one shared cursor, so they advance through the layers
+		// together and the first layers are resident first.
+		RT_TM_INLINE warm_up_telemetry warm_up(size_t thread_count = std::thread::hardware_concurrency()) const {
+			struct byte_range {
+				const uint8_t* data{};
+				uint64_t size{};
+			};
+			std::vector<const model_core*> ordered_cores{};
+			ordered_cores.reserve(model_cores.size());
+			for (auto& core: model_cores) {
+				ordered_cores.emplace_back(&core);
+			}
+			std::stable_sort(ordered_cores.begin(), ordered_cores.end(), [](const model_core* lhs, const model_core* rhs) {
+				return get_execution_order(lhs->name) < get_execution_order(rhs->name);
+			});
+			warm_up_telemetry return_value{};
+			std::vector<byte_range> chunks{};
+			for (auto& core: ordered_cores) {
+				const uint8_t* data{ static_cast<const uint8_t*>(core->data) };
+				for (uint64_t offset = 0; offset < core->byte_size; offset += warm_up_chunk_bytes) {
+					chunks.emplace_back(byte_range{ data + offset, std::min(warm_up_chunk_bytes, core->byte_size - offset) });
+				}
+				return_value.bytes += core->byte_size;
+			}
+			thread_count			  = std::max<size_t>(1, std::min<size_t>(thread_count, chunks.size()));
+			return_value.thread_count = thread_count;
+			const size_t page_size{ get_page_size() };
+			std::atomic<uint64_t> cursor{};
+			const auto start = std::chrono::steady_clock::now();
+			std::vector<std::thread> threads{};
+			threads.reserve(thread_count);
+			for (size_t x = 0; x < thread_count; ++x) {
+				threads.emplace_back([&chunks, &cursor, page_size] {
+					uint8_t sink{};
+					for (uint64_t index = cursor.fetch_add(1, std::memory_order_relaxed); index < chunks.size(); index = cursor.fetch_add(1, std::memory_order_relaxed)) {
+						const byte_range& chunk{ chunks[index] };
+						prefetch_pages(chunk.data, chunk.size);
+						const volatile uint8_t* data{ chunk.data };
+						for (uint64_t offset = 0; offset < chunk.size; offset += page_size) {
+							sink ^= data[offset];
+						}
+						sink ^= data[chunk.size - 1];
+					}
+					static_cast<void>(sink);
+				});
+			}
+			for (auto& thread: threads) {
+				thread.join();
+			}
+			return_value.nanoseconds		  = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+			return_value.gigabytes_per_second = return_value.nanoseconds ? static_cast<double>(return_value.bytes) / static_cast<double>(return_value.nanoseconds) : 0.0;
+			return return_value;
+		}
 	};
 
 }
\ No newline at end of file
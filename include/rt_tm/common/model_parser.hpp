@@ -27,8 +27,17 @@ OR OTHER DEALINGS IN THE SOFTWARE.
 
 #include <rt_tm/common/model_graph.hpp>
 #include <rt_tm/common/debugging_io.hpp>
+#include <rt_tm/common/telemetry.hpp>
+#include <algorithm>
+#include <charconv>
 #include <variant>
-#include <map>
+#include <cstdio>
+#include <future>
+#include <filesystem>
+#include <cstring>
+#include <array>
+#include <memory>
+#include <vector>
 #include <bit>
 
 namespace rt_tm {
@@ -59,7 +68,7 @@ namespace rt_tm {
 	template<typename value_type> struct value_reader {
 		RT_TM_FORCE_INLINE static gguf_metadata_value_type read_value(string_iterator& input) {
 			gguf_metadata_value_type value{};
-			if (input.current_index + sizeof(value) < input.length) {
+			if (input.current_index + sizeof(value) <= input.length) {
 				std::memcpy(&value, input.first_index + input.current_index, sizeof(value));
 				input.current_index += sizeof(value);
 			} else {
@@ -75,7 +84,7 @@ namespace rt_tm {
 	template<> struct value_reader<uint8_t> {
 		RT_TM_FORCE_INLINE static uint8_t read_value(string_iterator& input) {
 			uint8_t value{};
-			if (input.current_index + sizeof(value) < input.length) {
+			if (input.current_index + sizeof(value) <= input.length) {
 				std::memcpy(&value, input.first_index + input.current_index, sizeof(value));
 				input.current_index += sizeof(value);
 			} else {
@@ -88,7 +97,7 @@ namespace rt_tm {
 	template<> struct value_reader<uint16_t> {
 		RT_TM_FORCE_INLINE static uint16_t read_value(string_iterator& input) {
 			uint16_t value{};
-			if (input.current_index + sizeof(value) < input.length) {
+			if (input.current_index + sizeof(value) <= input.length) {
 				std::memcpy(&value, input.first_index + input.current_index, sizeof(value));
 				input.current_index += sizeof(value);
 			} else {
@@ -101,7 +110,7 @@ namespace rt_tm {
 	template<> struct value_reader<uint32_t> {
 		RT_TM_FORCE_INLINE static uint32_t read_value(string_iterator& input) {
 			uint32_t value{};
-			if (input.current_index + sizeof(value) < input.length) {
+			if (input.current_index + sizeof(value) <= input.length) {
 				std::memcpy(&value, input.first_index + input.current_index, sizeof(value));
 				input.current_index += sizeof(value);
 			} else {
@@ -114,7 +123,7 @@ namespace rt_tm {
 	template<> struct value_reader<uint64_t> {
 		RT_TM_FORCE_INLINE static uint64_t read_value(string_iterator& input) {
 			uint64_t value{};
-			if (input.current_index + sizeof(value) < input.length) {
+			if (input.current_index + sizeof(value) <= input.length) {
 				std::memcpy(&value, input.first_index + input.current_index, sizeof(value));
 				input.current_index += sizeof(value);
 			} else {
@@ -127,7 +136,7 @@ namespace rt_tm {
 	template<> struct value_reader<int8_t> {
 		RT_TM_FORCE_INLINE static int8_t read_value(string_iterator& input) {
 			int8_t value{};
-			if (input.current_index + sizeof(value) < input.length) {
+			if (input.current_index + sizeof(value) <= input.length) {
 				std::memcpy(&value, input.first_index + input.current_index, sizeof(value));
 				input.current_index += sizeof(value);
 			} else {
@@ -140,7 +149,7 @@ namespace rt_tm {
 	template<> struct value_reader<int16_t> {
 		RT_TM_FORCE_INLINE static int16_t read_value(string_iterator& input) {
 			int16_t value{};
-			if (input.current_index + sizeof(value) < input.length) {
+			if (input.current_index + sizeof(value) <= input.length) {
 				std::memcpy(&value, input.first_index + input.current_index, sizeof(value));
 				input.current_index += sizeof(value);
 			} else {
@@ -153,7 +162,7 @@ namespace rt_tm {
 	template<> struct value_reader<int32_t> {
 		RT_TM_FORCE_INLINE static int32_t read_value(string_iterator& input) {
 			int32_t value{};
-			if (input.current_index + sizeof(value) < input.length) {
+			if (input.current_index + sizeof(value) <= input.length) {
 				std::memcpy(&value, input.first_index + input.current_index, sizeof(value));
 				input.current_index += sizeof(value);
 			} else {
@@ -166,7 +175,7 @@ namespace rt_tm {
 	template<> struct value_reader<int64_t> {
 		RT_TM_FORCE_INLINE static int64_t read_value(string_iterator& input) {
 			int64_t value{};
-			if (input.current_index + sizeof(value) < input.length) {
+			if (input.current_index + sizeof(value) <= input.length) {
 				std::memcpy(&value, input.first_index + input.current_index, sizeof(value));
 				input.current_index += sizeof(value);
 			} else {
@@ -179,7 +188,7 @@ namespace rt_tm {
 	template<> struct value_reader<bool> {
 		RT_TM_FORCE_INLINE static bool read_value(string_iterator& input) {
 			bool value{};
-			if (input.current_index + sizeof(value) < input.length) {
+			if (input.current_index + sizeof(value) <= input.length) {
 				std::memcpy(&value, input.first_index + input.current_index, sizeof(value));
 				input.current_index += sizeof(value);
 			} else {
@@ -192,7 +201,7 @@ namespace rt_tm {
 	template<> struct value_reader<float> {
 		RT_TM_FORCE_INLINE static float read_value(string_iterator& input) {
 			float value{};
-			if (input.current_index + sizeof(value) < input.length) {
+			if (input.current_index + sizeof(value) <= input.length) {
 				std::memcpy(&value, input.first_index + input.current_index, sizeof(value));
 				input.current_index += sizeof(value);
 			} else {
@@ -205,7 +214,7 @@ namespace rt_tm {
 	template<> struct value_reader<double> {
 		RT_TM_FORCE_INLINE static double read_value(string_iterator& input) {
 			double value{};
-			if (input.current_index + sizeof(value) < input.length) {
+			if (input.current_index + sizeof(value) <= input.length) {
 				std::memcpy(&value, input.first_index + input.current_index, sizeof(value));
 				input.current_index += sizeof(value);
 			} else {
@@ -215,126 +224,85 @@ namespace rt_tm {
 		}
 	};
 
-	using gguf_string_t = std::string;
-
-	struct gguf_array_t;
-
-	using gguf_metadata_value_variant = std::variant<float, uint64_t, int64_t, double, bool, gguf_string_t, gguf_array_t*>;
-
-	template<typename value_type> struct non_unique_ptr {};
-
-	struct gguf_metadata_value_t {
-		gguf_metadata_value_t() noexcept = default;
-		gguf_metadata_value_t& operator=(const gguf_metadata_value_t& other) noexcept;
-		gguf_metadata_value_t(const gguf_metadata_value_t&other) noexcept {
-			*this = other;
-		};
-		gguf_metadata_value_t(const gguf_metadata_value_variant& other) noexcept;
-		gguf_metadata_value_variant value{};
-		~gguf_metadata_value_t();
-	};
+	using gguf_string_t = std::string_view;
 
+	// View over an encoded GGUF array inside the file buffer; elements are decoded on demand.
 	struct gguf_array_t {
-		std::vector<gguf_metadata_value_t> array{};
 		gguf_metadata_value_type type{};
+		const char* data_val{};
+		uint64_t byte_length{};
+		uint64_t count{};
+
+		template<typename function_type> RT_TM_INLINE void for_each(function_type&& function) const;
 	};
 
-	gguf_metadata_value_t::~gguf_metadata_value_t() {
-		switch (value.index()) {
-			case 6: {
-				if (std::get<gguf_array_t*>(value)) {
-					delete std::get<gguf_array_t*>(value);
-				}
-			}
-		}
-	}
+	using gguf_metadata_value_variant = std::variant<float, uint64_t, int64_t, double, bool, gguf_string_t, gguf_array_t>;
 
-	gguf_metadata_value_t& gguf_metadata_value_t::operator=(const gguf_metadata_value_t& other) noexcept {
-		switch (other.value.index()) {
-			case 0: {
-				value.emplace<float>(std::get<float>(other.value));
-				break;
-			}
-			case 1: {
-				value.emplace<uint64_t>(std::get<uint64_t>(other.value));
-				break;
-			}
-			case 2: {
-				value.emplace<int64_t>(std::get<int64_t>(other.value));
-				break;
-			}
-			case 3: {
-				value.emplace<double>(std::get<double>(other.value));
-				break;
-			}
-			case 4: {
-				value.emplace<bool>(std::get<bool>(other.value));
-				break;
-			}
-			case 5: {
-				value.emplace<gguf_string_t>(std::get<gguf_string_t>(other.value));
-				break;
-			}
-			case 6: {
-				value.emplace<gguf_array_t*>(new gguf_array_t{ *std::get<gguf_array_t*>(other.value) });
-				break;
+	template<> struct value_reader<gguf_string_t> {
+		RT_TM_FORCE_INLINE static gguf_string_t read_value(string_iterator& input) {
+			uint64_t length{ value_reader<uint64_t>::read_value(input) };
+			if (length > input.length - input.current_index) {
+				throw std::runtime_error{ "Sorry, but that index is out of range!" };
 			}
+			gguf_string_t value{ input.first_index + input.current_index, length };
+			input.current_index += length;
+			return value;
 		}
-		return *this;
 	};
 
-	gguf_metadata_value_t::gguf_metadata_value_t(const gguf_metadata_value_variant& other) noexcept {
-		switch (other.index()) {
-			case 0: {
-				value.emplace<float>(std::get<float>(other));
-				break;
-			}
-			case 1: {
-				value.emplace<uint64_t>(std::get<uint64_t>(other));
-				break;
-			}
-			case 2: {
-				value.emplace<int64_t>(std::get<int64_t>(other));
-				break;
+	RT_TM_FORCE_INLINE constexpr uint64_t get_fixed_value_size(gguf_metadata_value_type type) noexcept {
+		switch (type) {
+			case gguf_metadata_value_type::GGUF_METADATA_VALUE_TYPE_UINT8:
+			case gguf_metadata_value_type::GGUF_METADATA_VALUE_TYPE_INT8:
+			case gguf_metadata_value_type::GGUF_METADATA_VALUE_TYPE_BOOL: {
+				return 1;
 			}
-			case 3: {
-				value.emplace<double>(std::get<double>(other));
-				break;
+			case gguf_metadata_value_type::GGUF_METADATA_VALUE_TYPE_UINT16:
+			case gguf_metadata_value_type::GGUF_METADATA_VALUE_TYPE_INT16: {
+				return 2;
 			}
-			case 4: {
-				value.emplace<bool>(std::get<bool>(other));
-				break;
+			case gguf_metadata_value_type::GGUF_METADATA_VALUE_TYPE_UINT32:
+			case gguf_metadata_value_type::GGUF_METADATA_VALUE_TYPE_INT32:
+			case gguf_metadata_value_type::GGUF_METADATA_VALUE_TYPE_FLOAT32: {
+				return 4;
 			}
-			case 5: {
-				value.emplace<gguf_string_t>(std::get<gguf_string_t>(other));
-				break;
+			case gguf_metadata_value_type::GGUF_METADATA_VALUE_TYPE_UINT64:
+			case gguf_metadata_value_type::GGUF_METADATA_VALUE_TYPE_INT64:
+			case gguf_metadata_value_type::GGUF_METADATA_VALUE_TYPE_FLOAT64: {
+				return 8;
 			}
-			case 6: {
-				value.emplace<gguf_array_t*>(new gguf_array_t{ *std::get<gguf_array_t*>(other) });
-				break;
+			default: {
+				return 0;
 			}
 		}
-	};
+	}
 
-	template<> struct value_reader<gguf_string_t> {
-		RT_TM_FORCE_INLINE static gguf_string_t read_value(string_iterator& input) {
-			uint64_t length{ value_reader<uint64_t>::read_value(input) };
-			gguf_string_t value{};
-			value.resize(length);
-			if (input.current_index + length < input.length) {
-				std::memcpy(value.data(), input.first_index + input.current_index, length);
-				input.current_index += length;
-			} else {
-				throw std::runtime_error{ "Sorry, but that index is out of range!" };
+	template<> struct value_reader<gguf_array_t> {
+		RT_TM_INLINE static gguf_array_t read_value(string_iterator& input) {
+			gguf_array_t value{};
+			value.type	= value_reader<gguf_metadata_value_type>::read_value(input);
+			value.count = value_reader<uint64_t>::read_value(input);
+			const size_t start_index{ input.current_index };
+			if (const uint64_t fixed_size = get_fixed_value_size(value.type); fixed_size > 0) {
+				if (value.count > (input.length - input.current_index) / fixed_size) {
+					throw std::runtime_error{ "Sorry, but that index is out of range!" };
+				}
+				input.current_index += value.count * fixed_size;
+			} else if (value.type == gguf_metadata_value_type::GGUF_METADATA_VALUE_TYPE_STRING) {
+				for (size_t x = 0; x < value.count; ++x) {
+					value_reader<gguf_string_t>::read_value(input);
+				}
+			} else if (value.type == gguf_metadata_value_type::GGUF_METADATA_VALUE_TYPE_ARRAY) {
+				for (size_t x = 0; x < value.count; ++x) {
+					value_reader<gguf_array_t>::read_value(input);
+				}
 			}
+			value.data_val	  = input.first_index + start_index;
+			value.byte_length = input.current_index - start_index;
 			return value;
 		}
 	};
 
-	template<> struct value_reader<gguf_array_t> {
-		RT_TM_FORCE_INLINE static gguf_array_t read_value(string_iterator& input);
-	};
-
 	template<> struct value_reader<gguf_metadata_value_variant> {
 		RT_TM_INLINE static gguf_metadata_value_variant read_value(string_iterator& input, gguf_metadata_value_type type) {
 			gguf_metadata_value_variant value{};
@@ -388,7 +356,10 @@ namespace rt_tm {
 					break;
 				}
 				case gguf_metadata_value_type::GGUF_METADATA_VALUE_TYPE_ARRAY: {
-					value.emplace<gguf_array_t*>(new gguf_array_t{ value_reader<gguf_array_t>::read_value(input) });
+					value.emplace<gguf_array_t>(value_reader<gguf_array_t>::read_value(input));
+					break;
+				}
+				default: {
 					break;
 				}
 			}
@@ -396,63 +367,101 @@ namespace rt_tm {
 		}
 	};
 
-	gguf_array_t value_reader<gguf_array_t>::read_value(string_iterator& input) {
-		gguf_metadata_value_type type{ value_reader<gguf_metadata_value_type>::read_value(input) };
-		uint64_t length{ value_reader<uint64_t>::read_value(input) };
-		gguf_array_t value{};
-		value.type = type;
-		for (size_t x = 0; x < length; ++x) {
-			value.array.emplace_back(value_reader<gguf_metadata_value_variant>::read_value(input, type));
+	template<typename function_type> RT_TM_INLINE void gguf_array_t::for_each(function_type&& function) const {
+		string_iterator input{};
+		input.first_index = data_val;
+		input.length	  = byte_length;
+		for (size_t x = 0; x < count; ++x) {
+			function(value_reader<gguf_metadata_value_variant>::read_value(input, type));
 		}
-		return value;
 	}
 
-	struct gguf_metadata_kv_t;	
-
 	struct gguf_metadata_kv_t {
+		gguf_string_t key{};
 
 		gguf_metadata_value_type value_type{};
 
-		gguf_metadata_value_t value{};
+		gguf_metadata_value_variant value{};
 
 		RT_TM_FORCE_INLINE operator bool() const {
-			return std::get<bool>(value.value);
+			return std::get<bool>(value);
 		}
 
 		RT_TM_FORCE_INLINE operator int64_t() const {
-			return std::get<int64_t>(value.value);
+			return std::get<int64_t>(value);
 		}
 
 		RT_TM_FORCE_INLINE operator uint64_t() const {
-			return std::get<uint64_t>(value.value);
+			return std::get<uint64_t>(value);
 		}
 
 		RT_TM_FORCE_INLINE operator gguf_string_t() const {
-			return std::get<gguf_string_t>(value.value);
+			return std::get<gguf_string_t>(value);
 		}
 
 		RT_TM_FORCE_INLINE operator gguf_array_t() const {
-			return *std::get<gguf_array_t*>(value.value);
+			return std::get<gguf_array_t>(value);
 		}
 
 		RT_TM_FORCE_INLINE operator float() const {
-			return std::get<float>(value.value);
+			return std::get<float>(value);
 		}
 
 		RT_TM_FORCE_INLINE operator double() const {
-			return std::get<double>(value.value);
+			return std::get<double>(value);
 		}
 	};
 
 	template<> struct value_reader<gguf_metadata_kv_t> {
 		RT_TM_FORCE_INLINE static gguf_metadata_kv_t read_value(string_iterator& input) {
 			gguf_metadata_kv_t value{};
+			value.key		 = value_reader<gguf_string_t>::read_value(input);
 			value.value_type = value_reader<gguf_metadata_value_type>::read_value(input);
-			value.value.value	   = value_reader<gguf_metadata_value_variant>::read_value(input, value.value_type);
+			value.value		 = value_reader<gguf_metadata_value_variant>::read_value(input, value.value_type);
 			return value;
 		}
 	};
 
+	RT_TM_FORCE_INLINE uint64_t get_payload_size(const gguf_metadata_kv_t& value) noexcept {
+		switch (value.value_type) {
+			case gguf_metadata_value_type::GGUF_METADATA_VALUE_TYPE_STRING: {
+				return sizeof(uint64_t) + value.operator gguf_string_t().size();
+			}
+			case gguf_metadata_value_type::GGUF_METADATA_VALUE_TYPE_ARRAY: {
+				return sizeof(uint32_t) + sizeof(uint64_t) + value.operator gguf_array_t().byte_length;
+			}
+			default: {
+				return get_fixed_value_size(value.value_type);
+			}
+		}
+	}
+
+	// Flat, key-sorted metadata index whose keys and payloads all point into the file buffer.
+	struct gguf_metadata_store {
+		std::vector<gguf_metadata_kv_t> values{};
+
+		RT_TM_FORCE_INLINE void sort() {
+			std::stable_sort(values.begin(), values.end(), [](const gguf_metadata_kv_t& lhs, const gguf_metadata_kv_t& rhs) {
+				return lhs.key < rhs.key;
+			});
+		}
+
+		RT_TM_FORCE_INLINE const gguf_metadata_kv_t* find(std::string_view key) const noexcept {
+			auto it = std::lower_bound(values.begin(), values.end(), key, [](const gguf_metadata_kv_t& lhs, std::string_view rhs) {
+				return lhs.key < rhs;
+			});
+			return (it != values.end() && it->key == key) ? &*it : nullptr;
+		}
+
+		RT_TM_FORCE_INLINE bool contains(std::string_view key) const noexcept {
+			return find(key) != nullptr;
+		}
+
+		RT_TM_FORCE_INLINE size_t size() const noexcept {
+			return values.size();
+		}
+	};
+
 	struct gguf_header_t {
 		// Magic number to announce that this is a GGUF file.
 		// Must be `GGUF` at the byte level: `0x47` `0x47` `0x55` `0x46`.
@@ -463,14 +472,14 @@ namespace rt_tm {
 		uint32_t version{};
 		uint64_t tensor_count{};
 		uint64_t metadata_kv_count{};
-		std::map<std::string, gguf_metadata_kv_t> metadata_kv{};
+		gguf_metadata_store metadata_kv{};
 	};
 
-	RT_TM_FORCE_INLINE void read_u64(const std::string& key, uint64_t& out, const std::map<std::string, gguf_metadata_kv_t>& metadata_kv) {
+	RT_TM_FORCE_INLINE void read_u64(std::string_view key, uint64_t& out, const gguf_metadata_store& metadata_kv) {
 		auto it = metadata_kv.find(key);
-		if (it == metadata_kv.end())
+		if (!it)
 			return;
-		const auto& v = it->second.value.value;
+		const auto& v = it->value;
 		if (std::holds_alternative<uint64_t>(v)) {
 			out = std::get<uint64_t>(v);
 		} else if (std::holds_alternative<int64_t>(v)) {
@@ -478,77 +487,180 @@ namespace rt_tm {
 		}
 	};
 
-	RT_TM_FORCE_INLINE void read_f32(const std::string& key, float& out, const std::map<std::string, gguf_metadata_kv_t>& metadata_kv) {
+	RT_TM_FORCE_INLINE void read_f32(std::string_view key, float& out, const gguf_metadata_store& metadata_kv) {
 		auto it = metadata_kv.find(key);
-		if (it != metadata_kv.end() && std::holds_alternative<float>(it->second.value.value)) {
-			out = std::get<float>(it->second.value.value);
+		if (it && std::holds_alternative<float>(it->value)) {
+			out = std::get<float>(it->value);
 		}
 	};
 
-	RT_TM_FORCE_INLINE void read_str(const std::string& key, std::string& out, const std::map<std::string, gguf_metadata_kv_t>& metadata_kv) {
+	RT_TM_FORCE_INLINE void read_str(std::string_view key, std::string& out, const gguf_metadata_store& metadata_kv) {
 		auto it = metadata_kv.find(key);
-		if (it != metadata_kv.end() && std::holds_alternative<gguf_string_t>(it->second.value.value)) {
-			out = std::get<gguf_string_t>(it->second.value.value);
+		if (it && std::holds_alternative<gguf_string_t>(it->value)) {
+			out = std::get<gguf_string_t>(it->value);
 		}
 	};
 
-	RT_TM_FORCE_INLINE void read_str_array(const std::string& key, std::vector<std::string>& out, const std::map<std::string, gguf_metadata_kv_t>& metadata_kv) {
+	RT_TM_FORCE_INLINE void read_str_array(std::string_view key, string_pool& out, const gguf_metadata_store& metadata_kv) {
 		auto it = metadata_kv.find(key);
-		if (it == metadata_kv.end())
+		if (!it)
 			return;
-		const auto& v = it->second.value.value;
-		if (std::holds_alternative<gguf_array_t*>(v)) {
-			gguf_array_t& new_array{ *std::get<gguf_array_t*>(v) };
-			for (auto& value: new_array.array) {
-				out.emplace_back(std::get<gguf_string_t>(value.value));
+		const auto& v = it->value;
+		if (std::holds_alternative<gguf_array_t>(v)) {
+			const gguf_array_t& new_array{ std::get<gguf_array_t>(v) };
+			if (new_array.type != gguf_metadata_value_type::GGUF_METADATA_VALUE_TYPE_STRING) {
+				return;
 			}
+			out.reserve(out.size() + new_array.count, out.byte_size() + new_array.byte_length - new_array.count * sizeof(uint64_t));
+			new_array.for_each([&](const gguf_metadata_value_variant& value) {
+				out.emplace_back(std::get<gguf_string_t>(value));
+			});
 		}
 	};
 
-	RT_TM_FORCE_INLINE void read_int_array(const std::string& key, std::vector<int64_t>& out, const std::map<std::string, gguf_metadata_kv_t>& metadata_kv) {
+	RT_TM_FORCE_INLINE void read_int_array(std::string_view key, std::vector<int64_t>& out, const gguf_metadata_store& metadata_kv) {
 		auto it = metadata_kv.find(key);
-		if (it == metadata_kv.end())
+		if (!it)
 			return;
-		const auto& v = it->second.value.value;
-		if (std::holds_alternative<gguf_array_t*>(v)) {
-			gguf_array_t& new_array{ *std::get<gguf_array_t*>(v) };
-			for (auto& value: new_array.array) {
-				out.emplace_back(std::get<int64_t>(value.value));
-			}
+		const auto& v = it->value;
+		if (std::holds_alternative<gguf_array_t>(v)) {
+			const gguf_array_t& new_array{ std::get<gguf_array_t>(v) };
+			out.reserve(out.size() + new_array.count);
+			new_array.for_each([&](const gguf_metadata_value_variant& value) {
+				out.emplace_back(std::get<int64_t>(value));
+			});
+		}
+	};
+
+	enum class model_arch {
+		generic = 0,
+		llama	= 1,
+	};
+
+	RT_TM_FORCE_INLINE constexpr model_arch get_model_arch(std::string_view architecture) noexcept {
+		if (architecture == "llama") {
+			return model_arch::llama;
+		}
+		return model_arch::generic;
+	}
+
+	enum class hparam_scope {
+		global		 = 0,
+		architecture = 1,
+	};
+
+	using hparam_member = std::variant<uint64_t hyper_parameters::*, float hyper_parameters::*, std::string hyper_parameters::*>;
+
+	// One hyper_parameters field: its GGUF key (relative to "<architecture>." when scoped) and the member it fills.
+	struct hparam_key {
+		hparam_scope scope{};
+		std::string_view key{};
+		hparam_member member{};
+
+		RT_TM_FORCE_INLINE constexpr bool operator<(const hparam_key& other) const noexcept {
+			return scope != other.scope ? scope < other.scope : key < other.key;
 		}
 	};
 
+	template<size_t size> RT_TM_FORCE_INLINE constexpr std::array<hparam_key, size> sort_hparam_keys(std::array<hparam_key, size> keys) noexcept {
+		std::sort(keys.begin(), keys.end());
+		return keys;
+	}
+
+	inline static constexpr auto default_hparam_keys{ sort_hparam_keys(std::array{
+		hparam_key{ hparam_scope::global, "general.architecture", &hyper_parameters::architecture },
+		hparam_key{ hparam_scope::global, "general.file_type", &hyper_parameters::file_type },
+		hparam_key{ hparam_scope::global, "general.quantization_version", &hyper_parameters::quantization_version },
+		hparam_key{ hparam_scope::global, "quantize.imatrix.entries_count", &hyper_parameters::imatrix_entries_count },
+		hparam_key{ hparam_scope::global, "quantize.imatrix.chunks_count", &hyper_parameters::imatrix_chunks_count },
+		hparam_key{ hparam_scope::global, "quantize.imatrix.file", &hyper_parameters::imatrix_file },
+		hparam_key{ hparam_scope::architecture, "block_count", &hyper_parameters::block_count },
+		hparam_key{ hparam_scope::architecture, "context_length", &hyper_parameters::context_length },
+		hparam_key{ hparam_scope::architecture, "embedding_length", &hyper_parameters::embedding_length },
+		hparam_key{ hparam_scope::architecture, "feed_forward_length", &hyper_parameters::feed_forward_length },
+		hparam_key{ hparam_scope::architecture, "vocab_size", &hyper_parameters::vocab_size },
+		hparam_key{ hparam_scope::architecture, "expert_count", &hyper_parameters::expert_count },
+		hparam_key{ hparam_scope::architecture, "expert_used_count", &hyper_parameters::expert_used_count },
+		hparam_key{ hparam_scope::architecture, "attention.head_count", &hyper_parameters::head_count },
+		hparam_key{ hparam_scope::architecture, "attention.head_count_kv", &hyper_parameters::head_count_kv },
+		hparam_key{ hparam_scope::architecture, "attention.key_length", &hyper_parameters::key_length },
+		hparam_key{ hparam_scope::architecture, "attention.value_length", &hyper_parameters::value_length },
+		hparam_key{ hparam_scope::architecture, "attention.sliding_window", &hyper_parameters::sliding_window },
+		hparam_key{ hparam_scope::architecture, "attention.layer_norm_rms_epsilon", &hyper_parameters::rms_norm_epsilon },
+		hparam_key{ hparam_scope::architecture, "rope.dimension_count", &hyper_parameters::rope_dimension_count },
+		hparam_key{ hparam_scope::architecture, "rope.freq_base", &hyper_parameters::rope_freq_base },
+		hparam_key{ hparam_scope::architecture, "rope.scaling.type", &hyper_parameters::rope_scaling_type },
+		hparam_key{ hparam_scope::architecture, "rope.scaling.factor", &hyper_parameters::rope_scaling_factor },
+		hparam_key{ hparam_scope::architecture, "rope.scaling.original_context_length", &hyper_parameters::rope_scaling_original_context_length },
+	}) };
+
+	// Specialize to add, rename or drop keys for a single architecture.
+	template<model_arch arch> struct hparam_key_table {
+		inline static constexpr auto keys{ default_hparam_keys };
+	};
+
+	RT_TM_FORCE_INLINE void assign_hparam(uint64_t& out, const gguf_metadata_value_variant& value) noexcept {
+		if (std::holds_alternative<uint64_t>(value)) {
+			out = std::get<uint64_t>(value);
+		} else if (std::holds_alternative<int64_t>(value)) {
+			out = static_cast<uint64_t>(std::get<int64_t>(value));
+		}
+	}
+
+	RT_TM_FORCE_INLINE void assign_hparam(float& out, const gguf_metadata_value_variant& value) noexcept {
+		if (std::holds_alternative<float>(value)) {
+			out = std::get<float>(value);
+		} else if (std::holds_alternative<double>(value)) {
+			out = static_cast<float>(std::get<double>(value));
+		}
+	}
+
+	RT_TM_FORCE_INLINE void assign_hparam(std::string& out, const gguf_metadata_value_variant& value) {
+		if (std::holds_alternative<gguf_string_t>(value)) {
+			out = std::get<gguf_string_t>(value);
+		}
+	}
+
 	template<> struct value_reader<hyper_parameters> {
-		RT_TM_FORCE_INLINE static hyper_parameters read_value(const std::map<std::string, gguf_metadata_kv_t>& metadata_kv) {
-			hyper_parameters value{};
-			std::string architecture{};
-
-			if (metadata_kv.contains("general.architecture")) {
-				architecture = metadata_kv.at("general.architecture").operator gguf_string_t();
-			}
-
-			read_u64(architecture + ".block_count", value.block_count, metadata_kv);
-			read_u64(architecture + ".quantization_version", value.quantization_version, metadata_kv);
-			read_u64(architecture + ".rope_dimension_count", value.rope_dimension_count, metadata_kv);
-			read_u64(architecture + ".feed_forward_length", value.feed_forward_length, metadata_kv);
-			read_u64(architecture + ".embedding_length", value.embedding_length, metadata_kv);
-			read_u64(architecture + ".context_length", value.context_length, metadata_kv);
-			read_u64(architecture + ".head_count_kv", value.head_count_kv, metadata_kv);
-			read_u64(architecture + ".attention.head_count", value.head_count, metadata_kv);
-			read_u64(architecture + ".vocab_size", value.vocab_size, metadata_kv);
-			read_u64("general.file_type", value.file_type, metadata_kv);
-			read_f32(architecture + ".attention.layer_norm_rms_epsilon", value.rms_norm_epsilon, metadata_kv);
-			read_f32(architecture + ".rope.freq_base", value.rope_freq_base, metadata_kv);
-			read_u64("quantize.imatrix.entries_count", value.imatrix_entries_count, metadata_kv);
-			read_u64("quantize.imatrix.chunks_count", value.imatrix_chunks_count, metadata_kv);
-			read_str("quantize.imatrix.file", value.imatrix_file, metadata_kv);
+		RT_TM_FORCE_INLINE static hyper_parameters read_value(const gguf_metadata_store& metadata_kv) {
+			std::string_view architecture{};
+			if (auto it = metadata_kv.find("general.architecture"); it && std::holds_alternative<gguf_string_t>(it->value)) {
+				architecture = it->operator gguf_string_t();
+			}
+			switch (get_model_arch(architecture)) {
+				case model_arch::llama: {
+					return read_value<model_arch::llama>(metadata_kv, architecture);
+				}
+				default: {
+					return read_value<model_arch::generic>(metadata_kv, architecture);
+				}
+			}
+		}
 
+		template<model_arch arch> RT_TM_INLINE static hyper_parameters read_value(const gguf_metadata_store& metadata_kv, std::string_view architecture) {
+			static constexpr auto& keys{ hparam_key_table<arch>::keys };
+			hyper_parameters value{};
+			for (auto& kv: metadata_kv.values) {
+				hparam_key search_key{ hparam_scope::global, kv.key };
+				if (!architecture.empty() && kv.key.size() > architecture.size() && kv.key.starts_with(architecture) && kv.key[architecture.size()] == '.') {
+					search_key.scope = hparam_scope::architecture;
+					search_key.key	 = kv.key.substr(architecture.size() + 1);
+				}
+				auto it = std::lower_bound(keys.begin(), keys.end(), search_key);
+				if (it != keys.end() && it->scope == search_key.scope && it->key == search_key.key) {
+					std::visit(
+						[&](auto member) {
+							assign_hparam(value.*member, kv.value);
+						},
+						it->member);
+				}
+			}
 			return value;
 		}
 	};
 
 	template<> struct value_reader<tokenizer_parameters> {
-		RT_TM_FORCE_INLINE static tokenizer_parameters read_value(const std::map<std::string, gguf_metadata_kv_t>& metadata_kv) {
+		RT_TM_FORCE_INLINE static tokenizer_parameters read_value(const gguf_metadata_store& metadata_kv) {
 			tokenizer_parameters value{};
 
 			read_u64("tokenizer.ggml.bos_token_id", value.bos_token_id, metadata_kv);
@@ -563,8 +675,10 @@ namespace rt_tm {
 	};
 
 	template<> struct value_reader<gguf_header_t> {
-		RT_TM_FORCE_INLINE static gguf_header_t read_value(string_iterator& input) {
+		template<bool telemetry_enabled> RT_TM_FORCE_INLINE static gguf_header_t read_value(string_iterator& input, load_telemetry& telemetry) {
 			gguf_header_t value{};
+			phase_timer<telemetry_enabled> header_timer{ telemetry[load_phase::header] };
+			const size_t header_start{ input.current_index };
 			value.magic = value_reader<uint32_t>::read_value(input);
 			if (value.magic != 0x46554747) {
 				throw std::runtime_error{ "Sorry, but that magic value was incorrect!" };
@@ -572,37 +686,27 @@ namespace rt_tm {
 			value.version = value_reader<uint32_t>::read_value(input);
 			value.tensor_count = value_reader<uint64_t>::read_value(input);
 			value.metadata_kv_count = value_reader<uint64_t>::read_value(input);
+			header_timer.stop(input.current_index - header_start);
+			phase_timer<telemetry_enabled> kv_timer{ telemetry[load_phase::kv_decode] };
+			const size_t kv_start{ input.current_index };
+			value.metadata_kv.values.reserve(value.metadata_kv_count);
 			for (size_t x = 0; x < value.metadata_kv_count; ++x) {
-				std::string new_string = value_reader<gguf_string_t>::read_value(input);
-				std::cout << new_string << ": ";
-				value.metadata_kv[new_string] = value_reader<gguf_metadata_kv_t>::read_value(input);
-				if (value.metadata_kv[new_string].value_type == gguf_metadata_value_type::GGUF_METADATA_VALUE_TYPE_STRING) {
-					std::cout<< value.metadata_kv[new_string].operator std::string() << std::endl;
-				} else if (value.metadata_kv[new_string].value_type == gguf_metadata_value_type::GGUF_METADATA_VALUE_TYPE_INT32) {
-					std::cout << value.metadata_kv[new_string].operator int64_t() << std::endl;
-				} else if (value.metadata_kv[new_string].value_type == gguf_metadata_value_type::GGUF_METADATA_VALUE_TYPE_UINT32) {
-					
-					std::cout << value.metadata_kv[new_string].operator uint64_t() << std::endl;
-				} else {
-					std::cout << std::endl;
-				}
+				value.metadata_kv.values.emplace_back(value_reader<gguf_metadata_kv_t>::read_value(input));
 			}
-			std::cout<< std::hex << +value.magic << std::endl;
-			std::cout<< std::dec << +value.version << std::endl;
-			std::cout<< std::dec << +value.tensor_count << std::endl;
-			std::cout<< std::dec << +value.metadata_kv_count << std::endl;
+			value.metadata_kv.sort();
+			kv_timer.stop(input.current_index - kv_start);
 			return value;
 		}
 	};
 
-	uint64_t align_offset(uint64_t offset, size_t ALIGNMENT) {
+	RT_TM_FORCE_INLINE constexpr uint64_t align_offset(uint64_t offset, size_t ALIGNMENT) {
 		return offset + (ALIGNMENT - (offset % ALIGNMENT)) % ALIGNMENT;
 	}
 
 	struct gguf_tensor_info_t {
+		array<uint64_t, max_tensor_dimensions> dimensions{ 1, 1, 1, 1 };
 		gguf_string_t name{};
 		uint32_t n_dimensions{};
-		std::vector<uint64_t> dimensions{};
 		data_type type{};
 		uint64_t offset{};
 	};
@@ -612,45 +716,229 @@ namespace rt_tm {
 			gguf_tensor_info_t value{};
 			value.name = value_reader<gguf_string_t>::read_value(input);
 			value.n_dimensions = value_reader<uint32_t>::read_value(input);
+			if (value.n_dimensions > max_tensor_dimensions) {
+				throw std::runtime_error{ "Sorry, but that tensor has too many dimensions!" };
+			}
 			for (size_t x = 0; x < value.n_dimensions; ++x) {
-				value.dimensions.emplace_back(value_reader<uint64_t>::read_value(input));
+				value.dimensions[x] = value_reader<uint64_t>::read_value(input);
 			}
 			value.type = static_cast<data_type>(value_reader<uint32_t>::read_value(input));
+			if (static_cast<uint32_t>(value.type) >= static_cast<uint32_t>(data_type::count) || get_data_type_traits(value.type).block_size == 0) {
+				throw std::runtime_error{ "Sorry, but that tensor type is out of range!" };
+			}
 			value.offset = value_reader<uint64_t>::read_value(input);
-			std::cout<< std::hex << value.name << std::endl;
 			return value;
 		}
 	};
 
-	struct gguf_file_t {
-		gguf_header_t header{};
-		std::vector<gguf_tensor_info_t> tensor_infos{};
-		std::vector<uint8_t> _padding{};
-		std::vector<uint8_t> tensor_data{};
+	template<> struct value_reader<model_core> {
+		RT_TM_FORCE_INLINE static model_core read_value(const gguf_tensor_info_t& tensor_info, const char* tensor_data, size_t tensor_data_size) {
+			model_core value{};
+			const data_type_traits traits{ get_data_type_traits(tensor_info.type) };
+			if (tensor_info.dimensions[0] % traits.block_size != 0) {
+				throw std::runtime_error{ "Sorry, but that tensor's row length is not a multiple of its block size!" };
+			}
+			value.name		   = tensor_info.name;
+			value.type		   = tensor_info.type;
+			value.n_dimensions = tensor_info.n_dimensions;
+			value.dimensions   = tensor_info.dimensions;
+			value.strides[0]   = traits.type_size;
+			value.strides[1]   = get_row_size(tensor_info.type, tensor_info.dimensions[0]);
+			for (size_t x = 2; x < max_tensor_dimensions; ++x) {
+				value.strides[x] = value.strides[x - 1] * value.dimensions[x - 1];
+			}
+			value.byte_size = value.strides[max_tensor_dimensions - 1] * value.dimensions[max_tensor_dimensions - 1];
+			if (tensor_info.offset > tensor_data_size || value.byte_size > tensor_data_size - tensor_info.offset) {
+				throw std::runtime_error{ "Sorry, but that tensor's data lies outside of the file!" };
+			}
+			value.data = tensor_data + tensor_info.offset;
+			return value;
+		}
 	};
 
 	enum class model_format { gguf = 1 };
 
+	inline static constexpr uint64_t fnv1a_offset_basis{ 0xcbf29ce484222325ull };
+
+	// Identifies a model for caches derived from it: each shard hashes its size, header bytes and modification time.
+	RT_TM_FORCE_INLINE uint64_t fnv1a_hash(const void* data, size_t size, uint64_t hash = fnv1a_offset_basis) noexcept {
+		const uint8_t* bytes{ static_cast<const uint8_t*>(data) };
+		for (size_t x = 0; x < size; ++x) {
+			hash = (hash ^ bytes[x]) * 0x100000001b3ull;
+		}
+		return hash;
+	}
+
+	// Everything parsed out of one GGUF file; metadata and tensor views point into the file kept alive by file_handle.
+	struct gguf_shard_t {
+		std::shared_ptr<const void> file_handle{};
+		std::vector<model_core> model_cores{};
+		gguf_header_t header{};
+		load_telemetry telemetry{};
+		uint64_t hash{};
+	};
+
+	// Splits "<prefix>-00001-of-00003.gguf" into its prefix and shard count; returns a count of 1 for unsplit names.
+	RT_TM_INLINE uint64_t get_shard_count(std::string_view path, std::string_view& prefix) noexcept {
+		static constexpr std::string_view suffix{ ".gguf" };
+		static constexpr size_t pattern_length{ sizeof("-00001-of-00003.gguf") - 1 };
+		prefix = path;
+		if (path.size() < pattern_length || !path.ends_with(suffix)) {
+			return 1;
+		}
+		const std::string_view pattern{ path.substr(path.size() - pattern_length) };
+		uint64_t shard_index{};
+		uint64_t shard_count{};
+		if (pattern[0] != '-' || pattern.substr(6, 4) != "-of-" || std::from_chars(pattern.data() + 1, pattern.data() + 6, shard_index).ec != std::errc{} ||
+			std::from_chars(pattern.data() + 10, pattern.data() + 15, shard_count).ec != std::errc{} || shard_index != 1 || shard_count == 0) {
+			return 1;
+		}
+		prefix = path.substr(0, path.size() - pattern_length);
+		return shard_count;
+	}
+
+	RT_TM_INLINE std::string get_shard_path(std::string_view prefix, uint64_t shard_index, uint64_t shard_count) {
+		char suffix[64]{};
+		std::snprintf(suffix, sizeof(suffix), "-%05llu-of-%05llu.gguf", static_cast<unsigned long long>(shard_index + 1), static_cast<unsigned long long>(shard_count));
+		return std::string{ prefix } + suffix;
+	}
+
 	template<global_config config, model_format type> struct model_parser;
 
 	template<global_config config> struct model_parser<config, model_format::gguf> {
 		static_assert((std::endian::native == std::endian::little), "Sorry, but big-endian is not yet supported by the library");
+		inline static constexpr uint64_t default_alignment{ 32 };
+		inline static constexpr uint64_t hash_sample_count{ 256 };
+		inline static constexpr uint64_t hash_sample_bytes{ 4096 };
+
+		// Accepts a single file or the first shard of a split model; the remaining shards are discovered from the
+		// file name and parsed concurrently, and their tensor views are merged into one model_graph.
 		RT_TM_FORCE_INLINE static model_graph parse_model(std::string_view path) {
-			std::string data_val{};
 			model_graph return_value{};
-			data_val = file_loader<config.exceptions>{ path };
-			gguf_file_t gguf_file{};
-			string_iterator ptr{};
-			ptr.first_index	 = data_val.data();
-			ptr.length		 = data_val.size();
-			gguf_file.header = value_reader<gguf_header_t>::read_value(ptr);
-			for (size_t x = 0; x < gguf_file.header.tensor_count; ++x) {
-				gguf_file.tensor_infos.emplace_back(value_reader<gguf_tensor_info_t>::read_value(ptr));
-			}
-			return_value.hparams = value_reader<hyper_parameters>::read_value(gguf_file.header.metadata_kv);
-			return_value.tokenizer_params = value_reader<tokenizer_parameters>::read_value(gguf_file.header.metadata_kv);
+			std::string_view prefix{};
+			const uint64_t shard_count{ get_shard_count(path, prefix) };
+			std::vector<std::future<gguf_shard_t>> futures{};
+			futures.reserve(shard_count - 1);
+			for (uint64_t x = 1; x < shard_count; ++x) {
+				futures.emplace_back(std::async(std::launch::async, [shard_path = get_shard_path(prefix, x, shard_count)] {
+					return parse_shard(shard_path);
+				}));
+			}
+			std::vector<gguf_shard_t> shards{};
+			shards.reserve(shard_count);
+			shards.emplace_back(parse_shard(path));
+			for (auto& future: futures) {
+				shards.emplace_back(future.get());
+			}
+			uint64_t expected_shard_count{ 1 };
+			read_u64("split.count", expected_shard_count, shards.front().header.metadata_kv);
+			if (std::max<uint64_t>(expected_shard_count, 1) != shard_count) {
+				throw std::runtime_error{ "Sorry, but the shard count in the file name does not match split.count!" };
+			}
+			size_t tensor_count{};
+			for (uint64_t x = 0; x < shards.size(); ++x) {
+				uint64_t shard_index{};
+				read_u64("split.no", shard_index, shards[x].header.metadata_kv);
+				if (shard_index != x) {
+					throw std::runtime_error{ "Sorry, but that shard's split.no does not match its position!" };
+				}
+				tensor_count += shards[x].model_cores.size();
+			}
+			uint64_t expected_tensor_count{ tensor_count };
+			read_u64("split.tensors.count", expected_tensor_count, shards.front().header.metadata_kv);
+			if (expected_tensor_count != tensor_count) {
+				throw std::runtime_error{ "Sorry, but the shards do not contain split.tensors.count tensors!" };
+			}
+			return_value.model_cores.reserve(tensor_count);
+			return_value.file_handles.reserve(shards.size());
+			return_value.model_hash = fnv1a_offset_basis;
+			for (auto& shard: shards) {
+				return_value.model_cores.insert(return_value.model_cores.end(), shard.model_cores.begin(), shard.model_cores.end());
+				return_value.model_hash = fnv1a_hash(&shard.hash, sizeof(shard.hash), return_value.model_hash);
+				return_value.file_handles.emplace_back(std::move(shard.file_handle));
+				// Shards are parsed concurrently, so a phase took as long as its slowest shard while the bytes add up.
+				for (size_t x = 0; x < return_value.telemetry.phases.size(); ++x) {
+					return_value.telemetry.phases[x].nanoseconds = std::max(return_value.telemetry.phases[x].nanoseconds, shard.telemetry.phases[x].nanoseconds);
+					return_value.telemetry.phases[x].bytes += shard.telemetry.phases[x].bytes;
+				}
+			}
+			const gguf_metadata_store& metadata_kv{ shards.front().header.metadata_kv };
+			phase_timer<config.telemetry> tokenizer_timer{ return_value.telemetry[load_phase::tokenizer] };
+			return_value.tokenizer_params = value_reader<tokenizer_parameters>::read_value(metadata_kv);
+			tokenizer_timer.stop(0);
+			phase_timer<config.telemetry> hparams_timer{ return_value.telemetry[load_phase::hparams] };
+			return_value.hparams = value_reader<hyper_parameters>::read_value(metadata_kv);
+			hparams_timer.stop(0);
+			if constexpr (config.telemetry) {
+				for (auto& value: metadata_kv.values) {
+					const load_phase phase{ value.key.starts_with("tokenizer.") ? load_phase::tokenizer : load_phase::hparams };
+					return_value.telemetry[phase].bytes += get_payload_size(value);
+				}
+			}
+			if constexpr (config.numa) {
+				return_value.numa = return_value.place_numa(numa_topology::detect());
+			} else if constexpr (config.residency != residency_mode::none) {
+				return_value.residency = return_value.make_resident(config.residency);
+			}
 			return return_value;
 		}
+
+	  protected:
+		RT_TM_INLINE static gguf_shard_t parse_shard(std::string_view path) {
+			gguf_shard_t return_value{};
+			if constexpr (config.use_mmap) {
+				auto file = std::make_shared<memory_mapped_file<config.exceptions>>(path);
+				parse_shard_impl(return_value, file->data(), file->size());
+				return_value.file_handle = std::move(file);
+			} else {
+				auto file = std::make_shared<file_loader<config.exceptions>>(path);
+				parse_shard_impl(return_value, file->data(), file->size());
+				return_value.file_handle = std::move(file);
+			}
+			std::error_code error_code{};
+			const int64_t write_time{ static_cast<int64_t>(std::filesystem::last_write_time(path, error_code).time_since_epoch().count()) };
+			return_value.hash = fnv1a_hash(&write_time, sizeof(write_time), return_value.hash);
+			return return_value;
+		}
+
+		RT_TM_FORCE_INLINE static void parse_shard_impl(gguf_shard_t& return_value, const char* data_val, size_t size) {
+			string_iterator ptr{};
+			ptr.first_index		= data_val;
+			ptr.length			= size;
+			return_value.header = value_reader<gguf_header_t>::template read_value<config.telemetry>(ptr, return_value.telemetry);
+			phase_timer<config.telemetry> tensor_info_timer{ return_value.telemetry[load_phase::tensor_infos] };
+			const size_t tensor_info_start{ ptr.current_index };
+			std::vector<gguf_tensor_info_t> tensor_infos{};
+			tensor_infos.reserve(return_value.header.tensor_count);
+			for (size_t x = 0; x < return_value.header.tensor_count; ++x) {
+				tensor_infos.emplace_back(value_reader<gguf_tensor_info_t>::read_value(ptr));
+			}
+			uint64_t alignment{ default_alignment };
+			read_u64("general.alignment", alignment, return_value.header.metadata_kv);
+			if (alignment == 0 || (alignment & (alignment - 1)) != 0) {
+				throw std::runtime_error{ "Sorry, but general.alignment must be a power of two!" };
+			}
+			const uint64_t tensor_data_offset{ align_offset(ptr.current_index, alignment) };
+			if (tensor_data_offset > size) {
+				throw std::runtime_error{ "Sorry, but the tensor data offset lies outside of the file!" };
+			}
+			return_value.model_cores.reserve(tensor_infos.size());
+			for (auto& tensor_info: tensor_infos) {
+				return_value.model_cores.emplace_back(value_reader<model_core>::read_value(tensor_info, data_val + tensor_data_offset, size - tensor_data_offset));
+			}
+			tensor_info_timer.stop(ptr.current_index - tensor_info_start);
+			const uint64_t file_size{ size };
+			return_value.hash = fnv1a_hash(&file_size, sizeof(file_size));
+			return_value.hash = fnv1a_hash(data_val, tensor_data_offset, return_value.hash);
+			// Evenly spaced pages of the tensor data, so a file rewritten with the same header and mtime still hashes
+			// differently without reading every weight.
+			const uint64_t data_size{ size - tensor_data_offset };
+			const uint64_t sample_bytes{ std::min(hash_sample_bytes, data_size) };
+			for (uint64_t x = 0; x < hash_sample_count && sample_bytes > 0; ++x) {
+				const uint64_t offset{ (data_size - sample_bytes) * x / (hash_sample_count - 1) };
+				return_value.hash = fnv1a_hash(data_val + tensor_data_offset + offset, sample_bytes, return_value.hash);
+			}
+		}
 	};
 
 }
@@ -0,0 +1,228 @@
+/*
+MIT License
+
+Copyright (c) 2025 RealTimeChris (Chris M)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "RT-TM Library"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+This file was independently created by RealTimeChris (Chris M), without reuse
+or derivation from any codebase owned by other entities, including any contract work.
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT
+OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#pragma once
+
+#include <rt_tm/common/allocator.hpp>
+#include <rt_tm/common/config.hpp>
+#include <string_view>
+#include <charconv>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#if defined(RT_TM_PLATFORM_LINUX)
+	#include <sys/syscall.h>
+	#include <pthread.h>
+	#include <sched.h>
+#endif
+
+namespace rt_tm {
+
+	struct numa_node {
+		uint32_t id{};
+		std::vector<uint32_t> cpus{};
+	};
+
+	// The NUMA nodes of the host and the cpus belonging to each. A simulated topology comes from a description string
+	// instead of the OS; it drives the same placement and pinning logic but never asks the kernel to bind memory.
+	struct numa_topology {
+		inline static constexpr std::string_view environment_variable{ "RT_TM_NUMA_TOPOLOGY" };
+		inline static constexpr uint32_t max_cpu_id{ 65535 };
+
+		std::vector<numa_node> nodes{};
+		bool simulated{};
+
+		// Parses a sysfs-style cpu list such as "0-3,8,10-11"; malformed ranges and ids above max_cpu_id are dropped.
+		RT_TM_INLINE static std::vector<uint32_t> parse_cpu_list(std::string_view cpu_list) {
+			std::vector<uint32_t> return_value{};
+			while (!cpu_list.empty()) {
+				const size_t comma{ cpu_list.find(',') };
+				const std::string_view range{ cpu_list.substr(0, comma) };
+				uint32_t first{};
+				uint32_t last{};
+				const auto result = std::from_chars(range.data(), range.data() + range.size(), first);
+				last			  = first;
+				if (result.ptr != range.data() + range.size() && *result.ptr == '-') {
+					std::from_chars(result.ptr + 1, range.data() + range.size(), last);
+				}
+				for (uint32_t cpu = first; cpu <= last && cpu <= max_cpu_id && result.ec == std::errc{}; ++cpu) {
+					return_value.emplace_back(cpu);
+				}
+				cpu_list = comma == std::string_view::npos ? std::string_view{} : cpu_list.substr(comma + 1);
+			}
+			return return_value;
+		}
+
+		// Builds a simulated topology from ';'-separated cpu lists, one per node, e.g. "0-3;4-7".
+		RT_TM_INLINE static numa_topology from_description(std::string_view description) {
+			numa_topology return_value{ .simulated = true };
+			while (!description.empty()) {
+				const size_t separator{ description.find(';') };
+				numa_node node{ static_cast<uint32_t>(return_value.nodes.size()), parse_cpu_list(description.substr(0, separator)) };
+				if (!node.cpus.empty()) {
+					return_value.nodes.emplace_back(std::move(node));
+				}
+				description = separator == std::string_view::npos ? std::string_view{} : description.substr(separator + 1);
+			}
+			return return_value;
+		}
+
+		// Reads RT_TM_NUMA_TOPOLOGY when it is set and describes at least one node, then sysfs on Linux, and otherwise
+		// reports one node with every cpu.
+		RT_TM_INLINE static numa_topology detect() {
+			if (const char* description = std::getenv(environment_variable.data()); description && *description) {
+				if (numa_topology simulated_topology{ from_description(description) }; !simulated_topology.nodes.empty()) {
+					return simulated_topology;
+				}
+			}
+			numa_topology return_value{};
+#if defined(RT_TM_PLATFORM_LINUX)
+			// Node ids can be sparse (offlined nodes), and memory-only nodes such as CXL or HBM have no cpus to run workers on.
+			std::ifstream online_file{ "/sys/devices/system/node/online" };
+			std::string online_list{};
+			if (online_file && std::getline(online_file, online_list)) {
+				for (uint32_t id: parse_cpu_list(online_list)) {
+					std::ifstream file{ "/sys/devices/system/node/node" + std::to_string(id) + "/cpulist" };
+					std::string cpu_list{};
+					if (file && std::getline(file, cpu_list)) {
+						if (numa_node node{ id, parse_cpu_list(cpu_list) }; !node.cpus.empty()) {
+							return_value.nodes.emplace_back(std::move(node));
+						}
+					}
+				}
+			}
+#endif
+			if (return_value.nodes.empty()) {
+				numa_node node{};
+				for (uint32_t x = 0; x < std::max(std::thread::hardware_concurrency(), 1u); ++x) {
+					node.cpus.emplace_back(x);
+				}
+				return_value.nodes.emplace_back(std::move(node));
+			}
+			return return_value;
+		}
+
+		RT_TM_FORCE_INLINE size_t size() const noexcept {
+			return nodes.size();
+		}
+
+		// Workers are split into contiguous blocks, one block per node.
+		RT_TM_FORCE_INLINE size_t get_worker_node(size_t thread_index, size_t thread_count) const noexcept {
+			return thread_count == 0 ? 0 : thread_index * nodes.size() / thread_count;
+		}
+
+		// The block of workers [first, second) that get_worker_node assigns to node.
+		RT_TM_FORCE_INLINE std::pair<size_t, size_t> get_node_workers(size_t node, size_t thread_count) const noexcept {
+			const size_t node_count{ std::max<size_t>(nodes.size(), 1) };
+			return { (node * thread_count + node_count - 1) / node_count, ((node + 1) * thread_count + node_count - 1) / node_count };
+		}
+	};
+
+	// Restricts the calling thread to the given cpus. Simulated cpu ids wrap around the cpus that actually exist; real
+	// ids are used as they are, since with cpus offline the highest id exceeds the online count.
+	RT_TM_INLINE bool pin_thread_to_cpus(const std::vector<uint32_t>& cpus, bool simulated = false) noexcept {
+		const uint32_t cpu_count{ std::max(std::thread::hardware_concurrency(), 1u) };
+#if defined(RT_TM_PLATFORM_LINUX)
+		cpu_set_t cpu_set{};
+		CPU_ZERO(&cpu_set);
+		bool any_cpu{};
+		for (uint32_t cpu: cpus) {
+			const uint32_t id{ simulated ? cpu % cpu_count : cpu };
+			if (id < CPU_SETSIZE) {
+				CPU_SET(id, &cpu_set);
+				any_cpu = true;
+			}
+		}
+		return any_cpu && pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set) == 0;
+#elif defined(RT_TM_PLATFORM_WINDOWS)
+		DWORD_PTR mask{};
+		for (uint32_t cpu: cpus) {
+			const uint32_t id{ simulated ? cpu % cpu_count : cpu };
+			if (id < sizeof(DWORD_PTR) * 8) {
+				mask |= DWORD_PTR{ 1 } << id;
+			}
+		}
+		return mask != 0 && SetThreadAffinityMask(GetCurrentThread(), mask) != 0;
+#else
+		static_cast<void>(cpus);
+		static_cast<void>(simulated);
+		static_cast<void>(cpu_count);
+		return false;
+#endif
+	}
+
+	RT_TM_FORCE_INLINE bool pin_worker(const numa_topology& topology, size_t thread_index, size_t thread_count) noexcept {
+		const size_t node{ topology.get_worker_node(thread_index, thread_count) };
+		return node < topology.size() && pin_thread_to_cpus(topology.nodes[node].cpus, topology.simulated);
+	}
+
+	// Binds the not-yet-touched pages of [ptr, ptr + size) to OS node node_id with mbind(MPOL_BIND); pages are placed
+	// there on first touch. Only Linux supports this.
+	RT_TM_INLINE bool bind_pages_to_os_node(void* ptr, size_t size, uint32_t node_id) noexcept {
+#if defined(RT_TM_PLATFORM_LINUX) && defined(SYS_mbind)
+		static constexpr int32_t mpol_bind{ 2 };
+		static constexpr uint32_t mpol_mf_move{ 1u << 1 };
+		if (!ptr || size == 0 || node_id >= 64) {
+			return false;
+		}
+		const size_t page_size{ get_page_size() };
+		const uintptr_t begin{ reinterpret_cast<uintptr_t>(ptr) & ~(page_size - 1) };
+		const uintptr_t end{ roundUpToMultiple<uintptr_t>(reinterpret_cast<uintptr_t>(ptr) + size, page_size) };
+		const uint64_t node_mask{ uint64_t{ 1 } << node_id };
+		return syscall(SYS_mbind, begin, end - begin, mpol_bind, &node_mask, uint64_t{ 65 }, mpol_mf_move) == 0;
+#else
+		static_cast<void>(ptr);
+		static_cast<void>(size);
+		static_cast<void>(node_id);
+		return false;
+#endif
+	}
+
+	// Simulated topologies skip the binding; their placement and pinning still run.
+	RT_TM_FORCE_INLINE bool bind_pages_to_node(const numa_topology& topology, void* ptr, size_t size, size_t node) noexcept {
+		return !topology.simulated && node < topology.size() && bind_pages_to_os_node(ptr, size, topology.nodes[node].id);
+	}
+
+	// The OS node of the cpu the calling thread is running on.
+	RT_TM_INLINE uint32_t get_current_node() noexcept {
+#if defined(RT_TM_PLATFORM_LINUX) && defined(SYS_getcpu)
+		uint32_t cpu{};
+		uint32_t node{};
+		return syscall(SYS_getcpu, &cpu, &node, nullptr) == 0 ? node : 0;
+#elif defined(RT_TM_PLATFORM_WINDOWS)
+		PROCESSOR_NUMBER processor{};
+		GetCurrentProcessorNumberEx(&processor);
+		USHORT node{};
+		return GetNumaProcessorNodeEx(&processor, &node) ? node : 0;
+#else
+		return 0;
+#endif
+	}
+
+}
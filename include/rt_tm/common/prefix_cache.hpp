@@ -0,0 +1,172 @@
+/*
+MIT License
+
+Copyright (c) 2025 RealTimeChris (Chris M)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "RT-TM Library"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+This file was independently created by RealTimeChris (Chris M), without reuse
+or derivation from any codebase owned by other entities, including any contract work.
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT
+OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#pragma once
+
+#include <rt_tm/common/input_session.hpp>
+#include <rt_tm/common/telemetry.hpp>
+#include <rt_tm/common/kv_cache.hpp>
+#include <rt_tm/common/common.hpp>
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <map>
+#include <vector>
+
+namespace rt_tm {
+
+	// A radix tree over token sequences whose digits are whole KV blocks: each edge is labelled with the
+	// block_tokens token ids one block holds and leads to the node owning that block. Sessions that start with a
+	// cached prefix adopt the shared blocks instead of recomputing them, and copy a block on write if they diverge
+	// inside it.
+	template<global_config config> class kv_prefix_cache {
+	  public:
+		RT_TM_INLINE kv_prefix_cache(kv_block_pool<config>& pool_new) noexcept : pool{ &pool_new } {
+		}
+
+		kv_prefix_cache(const kv_prefix_cache&)			   = delete;
+		kv_prefix_cache& operator=(const kv_prefix_cache&) = delete;
+
+		RT_TM_INLINE ~kv_prefix_cache() noexcept {
+			clear();
+		}
+
+		// Gives an empty session the longest cached prefix of tokens, always leaving at least the last token to be
+		// computed so its logits are produced; returns the number of tokens whose prefill can be skipped.
+		RT_TM_INLINE uint64_t attach(input_session<config>& session, std::span<const int64_t> tokens) {
+			const uint64_t block_tokens{ pool->get_config().block_tokens };
+			std::vector<uint32_t> blocks{};
+			std::unique_lock lock{ mutex };
+			node* current{ &root };
+			for (uint64_t offset = 0; offset + block_tokens < tokens.size(); offset += block_tokens) {
+				auto iterator = current->children.find(std::vector<int64_t>{ tokens.begin() + offset, tokens.begin() + offset + block_tokens });
+				if (iterator == current->children.end()) {
+					break;
+				}
+				current			   = iterator->second.get();
+				current->last_used = ++clock;
+				blocks.emplace_back(current->block);
+			}
+			const uint64_t saved_tokens{ blocks.size() * block_tokens };
+			++telemetry.lookups;
+			telemetry.hits += saved_tokens > 0;
+			telemetry.looked_up_tokens += tokens.size();
+			telemetry.saved_tokens += saved_tokens;
+			session.adopt_prefix(blocks);
+			return saved_tokens;
+		}
+
+		// Publishes the session's full blocks under the tokens they were computed from; tokens[x] must be the token
+		// at position x of the session.
+		RT_TM_INLINE void insert(const input_session<config>& session, std::span<const int64_t> tokens) {
+			const uint64_t block_tokens{ pool->get_config().block_tokens };
+			const std::vector<uint32_t>& block_table{ session.get_block_table() };
+			const uint64_t full_blocks{ std::min<uint64_t>(std::min<uint64_t>(session.token_count(), tokens.size()) / block_tokens, block_table.size()) };
+			std::unique_lock lock{ mutex };
+			node* current{ &root };
+			for (uint64_t x = 0; x < full_blocks; ++x) {
+				auto [iterator, inserted] = current->children.try_emplace(
+					std::vector<int64_t>{ tokens.begin() + x * block_tokens, tokens.begin() + (x + 1) * block_tokens }, nullptr);
+				if (inserted) {
+					iterator->second		 = std::make_unique<node>();
+					iterator->second->parent = current;
+					iterator->second->block	 = block_table[x];
+					pool->retain_block(block_table[x]);
+					++telemetry.cached_blocks;
+				}
+				current			   = iterator->second.get();
+				current->last_used = ++clock;
+			}
+		}
+
+		// Drops up to block_count least recently used leaves that no session references; returns how many went.
+		RT_TM_INLINE uint64_t evict(uint64_t block_count) {
+			std::unique_lock lock{ mutex };
+			uint64_t return_value{};
+			while (return_value < block_count) {
+				node* victim{};
+				collect_victim(root, victim);
+				if (!victim) {
+					break;
+				}
+				pool->release_block(victim->block);
+				auto& siblings{ victim->parent->children };
+				siblings.erase(std::find_if(siblings.begin(), siblings.end(), [victim](const auto& child) {
+					return child.second.get() == victim;
+				}));
+				--telemetry.cached_blocks;
+				++return_value;
+			}
+			return return_value;
+		}
+
+		RT_TM_INLINE void clear() noexcept {
+			std::unique_lock lock{ mutex };
+			release_children(root);
+			telemetry.cached_blocks = 0;
+		}
+
+		RT_TM_INLINE prefix_cache_telemetry get_telemetry() const {
+			std::unique_lock lock{ mutex };
+			return telemetry;
+		}
+
+	  protected:
+		struct node {
+			std::map<std::vector<int64_t>, std::unique_ptr<node>> children{};
+			node* parent{};
+			uint64_t last_used{};
+			uint32_t block{ kv_block_pool<config>::invalid_block };
+		};
+
+		prefix_cache_telemetry telemetry{};
+		kv_block_pool<config>* pool{};
+		mutable std::mutex mutex{};
+		uint64_t clock{};
+		node root{};
+
+		RT_TM_INLINE void collect_victim(node& current, node*& victim) const {
+			for (auto& [tokens, child]: current.children) {
+				if (child->children.empty()) {
+					if (pool->get_ref_count(child->block) == 1 && (!victim || child->last_used < victim->last_used)) {
+						victim = child.get();
+					}
+				} else {
+					collect_victim(*child, victim);
+				}
+			}
+		}
+
+		RT_TM_INLINE void release_children(node& current) noexcept {
+			for (auto& [tokens, child]: current.children) {
+				release_children(*child);
+				pool->release_block(child->block);
+			}
+			current.children.clear();
+		}
+	};
+
+}
@@ -0,0 +1,486 @@
+/*
+MIT License
+
+Copyright (c) 2025 RealTimeChris (Chris M)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "RT-TM Library"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+This file was independently created by RealTimeChris (Chris M), without reuse
+or derivation from any codebase owned by other entities, including any contract work.
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT
+OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#pragma once
+
+#include <rt_tm/common/config.hpp>
+#include <rt_tm/common/type_traits.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <cmath>
+#include <bit>
+
+namespace rt_tm {
+
+	// IEEE half <-> single conversion in plain integer arithmetic, so it works in every ISA tier without F16C.
+	RT_TM_FORCE_INLINE float fp16_to_fp32(uint16_t value) noexcept {
+		const uint32_t w{ static_cast<uint32_t>(value) << 16 };
+		const uint32_t sign{ w & 0x80000000u };
+		const uint32_t two_w{ w + w };
+		const float normalized_value{ std::bit_cast<float>((two_w >> 4) + (0xE0u << 23)) * 0x1.0p-112f };
+		const float denormalized_value{ std::bit_cast<float>((two_w >> 17) | (126u << 23)) - 0.5f };
+		const uint32_t result{ sign | (two_w < (1u << 27) ? std::bit_cast<uint32_t>(denormalized_value) : std::bit_cast<uint32_t>(normalized_value)) };
+		return std::bit_cast<float>(result);
+	}
+
+	RT_TM_FORCE_INLINE uint16_t fp32_to_fp16(float value) noexcept {
+		float base{ (std::fabs(value) * 0x1.0p+112f) * 0x1.0p-110f };
+		const uint32_t w{ std::bit_cast<uint32_t>(value) };
+		const uint32_t shl1_w{ w + w };
+		const uint32_t sign{ w & 0x80000000u };
+		const uint32_t bias{ std::max(shl1_w & 0xFF000000u, 0x71000000u) };
+		base = std::bit_cast<float>((bias >> 1) + 0x07800000u) + base;
+		const uint32_t bits{ std::bit_cast<uint32_t>(base) };
+		const uint32_t nonsign{ ((bits >> 13) & 0x00007C00u) + (bits & 0x00000FFFu) };
+		return static_cast<uint16_t>((sign >> 16) | (shl1_w > 0xFF000000u ? 0x7E00u : nonsign));
+	}
+
+	inline static constexpr uint64_t q8_0_block_size{ 32 };
+	inline static constexpr uint64_t q4_0_block_size{ 32 };
+
+	struct block_q8_0 {
+		uint16_t scale;
+		int8_t quants[q8_0_block_size];
+	};
+
+	struct block_q4_0 {
+		uint16_t scale;
+		uint8_t quants[q4_0_block_size / 2];
+	};
+
+	static_assert(sizeof(block_q8_0) == get_data_type_traits(data_type::q8_0).type_size);
+	static_assert(sizeof(block_q4_0) == get_data_type_traits(data_type::q4_0).type_size);
+
+	// Symmetric 8-bit blocks: x = scale * q with scale = max|x| / 127.
+	RT_TM_INLINE void quantize_row_q8_0(const float* input, block_q8_0* output, uint64_t count) noexcept {
+		for (uint64_t block = 0; block < count / q8_0_block_size; ++block) {
+			const float* values{ input + block * q8_0_block_size };
+			float max_abs{};
+			for (uint64_t x = 0; x < q8_0_block_size; ++x) {
+				max_abs = std::max(max_abs, std::fabs(values[x]));
+			}
+			const float scale{ max_abs / 127.0f };
+			const float inverse_scale{ scale != 0.0f ? 1.0f / scale : 0.0f };
+			output[block].scale = fp32_to_fp16(scale);
+			for (uint64_t x = 0; x < q8_0_block_size; ++x) {
+				output[block].quants[x] = static_cast<int8_t>(std::round(values[x] * inverse_scale));
+			}
+		}
+	}
+
+	RT_TM_INLINE void dequantize_row_q8_0(const block_q8_0* input, float* output, uint64_t count) noexcept {
+		for (uint64_t block = 0; block < count / q8_0_block_size; ++block) {
+			const float scale{ fp16_to_fp32(input[block].scale) };
+			for (uint64_t x = 0; x < q8_0_block_size; ++x) {
+				output[block * q8_0_block_size + x] = scale * static_cast<float>(input[block].quants[x]);
+			}
+		}
+	}
+
+	// 4-bit blocks with an implicit offset of 8: x = scale * (q - 8), where scale = -extreme / 8 keeps the value
+	// of largest magnitude exact. Elements 0..15 go in the low nibbles and 16..31 in the high nibbles.
+	RT_TM_INLINE void quantize_row_q4_0(const float* input, block_q4_0* output, uint64_t count) noexcept {
+		for (uint64_t block = 0; block < count / q4_0_block_size; ++block) {
+			const float* values{ input + block * q4_0_block_size };
+			float extreme{};
+			for (uint64_t x = 0; x < q4_0_block_size; ++x) {
+				if (std::fabs(values[x]) > std::fabs(extreme)) {
+					extreme = values[x];
+				}
+			}
+			const float scale{ extreme / -8.0f };
+			const float inverse_scale{ scale != 0.0f ? 1.0f / scale : 0.0f };
+			output[block].scale = fp32_to_fp16(scale);
+			for (uint64_t x = 0; x < q4_0_block_size / 2; ++x) {
+				const uint8_t low{ static_cast<uint8_t>(std::min(15, static_cast<int32_t>(values[x] * inverse_scale + 8.5f))) };
+				const uint8_t high{ static_cast<uint8_t>(std::min(15, static_cast<int32_t>(values[x + q4_0_block_size / 2] * inverse_scale + 8.5f))) };
+				output[block].quants[x] = static_cast<uint8_t>(low | (high << 4));
+			}
+		}
+	}
+
+	RT_TM_INLINE void dequantize_row_q4_0(const block_q4_0* input, float* output, uint64_t count) noexcept {
+		for (uint64_t block = 0; block < count / q4_0_block_size; ++block) {
+			const float scale{ fp16_to_fp32(input[block].scale) };
+			for (uint64_t x = 0; x < q4_0_block_size / 2; ++x) {
+				output[block * q4_0_block_size + x]						   = scale * static_cast<float>((input[block].quants[x] & 0x0F) - 8);
+				output[block * q4_0_block_size + x + q4_0_block_size / 2] = scale * static_cast<float>((input[block].quants[x] >> 4) - 8);
+			}
+		}
+	}
+
+	// Scalar reference for the q8_0 x q8_0 dot product; the SIMD tiers must agree with it up to float reassociation.
+	RT_TM_INLINE float vec_dot_q8_0_q8_0(const block_q8_0* weights, const block_q8_0* activations, uint64_t block_count) noexcept {
+		float sum{};
+		for (uint64_t block = 0; block < block_count; ++block) {
+			int32_t block_sum{};
+			for (uint64_t x = 0; x < q8_0_block_size; ++x) {
+				block_sum += static_cast<int32_t>(weights[block].quants[x]) * static_cast<int32_t>(activations[block].quants[x]);
+			}
+			sum += fp16_to_fp32(weights[block].scale) * fp16_to_fp32(activations[block].scale) * static_cast<float>(block_sum);
+		}
+		return sum;
+	}
+
+	RT_TM_INLINE void matvec_q8_0(const block_q8_0* weights, const block_q8_0* activations, float* output, uint64_t row_count, uint64_t block_count) noexcept {
+		for (uint64_t row = 0; row < row_count; ++row) {
+			output[row] = vec_dot_q8_0_q8_0(weights + row * block_count, activations, block_count);
+		}
+	}
+
+	// K-quants: 256-element super-blocks split into sub-blocks, each with its own 6-bit (q4_k, q5_k) or 8-bit (q6_k)
+	// scale. q4_k and q5_k also carry 6-bit mins, so x = scale * sub_scale * q - min_scale * sub_min.
+	inline static constexpr uint64_t q_k_block_size{ 256 };
+
+	struct block_q4_k {
+		uint16_t scale;
+		uint16_t min_scale;
+		uint8_t scales[12];
+		uint8_t quants[q_k_block_size / 2];
+	};
+
+	struct block_q5_k {
+		uint16_t scale;
+		uint16_t min_scale;
+		uint8_t scales[12];
+		uint8_t high_bits[q_k_block_size / 8];
+		uint8_t quants[q_k_block_size / 2];
+	};
+
+	struct block_q6_k {
+		uint8_t low_bits[q_k_block_size / 2];
+		uint8_t high_bits[q_k_block_size / 4];
+		int8_t scales[q_k_block_size / 16];
+		uint16_t scale;
+	};
+
+	// Activation side of the K-quant dot products. block_sums holds the sum of every 16 quants, which is all the
+	// min and offset terms of the weight formats need.
+	struct block_q8_k {
+		float scale;
+		int8_t quants[q_k_block_size];
+		int16_t block_sums[q_k_block_size / 16];
+	};
+
+	static_assert(sizeof(block_q4_k) == get_data_type_traits(data_type::q4_k).type_size);
+	static_assert(sizeof(block_q5_k) == get_data_type_traits(data_type::q5_k).type_size);
+	static_assert(sizeof(block_q6_k) == get_data_type_traits(data_type::q6_k).type_size);
+	static_assert(sizeof(block_q8_k) == get_data_type_traits(data_type::q8_k).type_size);
+
+	// Splits the 12 packed bytes of q4_k/q5_k into eight 6-bit scales followed by eight 6-bit mins.
+	RT_TM_FORCE_INLINE void unpack_k_scales(const uint8_t* packed, uint8_t* output) noexcept {
+		for (uint64_t x = 0; x < 4; ++x) {
+			output[x]	  = packed[x] & 63;
+			output[x + 8] = packed[x + 4] & 63;
+		}
+		for (uint64_t x = 4; x < 8; ++x) {
+			output[x]	  = static_cast<uint8_t>((packed[x + 4] & 0x0F) | ((packed[x - 4] >> 6) << 4));
+			output[x + 8] = static_cast<uint8_t>((packed[x + 4] >> 4) | ((packed[x] >> 6) << 4));
+		}
+	}
+
+	// Sum of sub_min * (sum of the sub-block's activation quants) over one super-block; the min term of q4_k and q5_k.
+	RT_TM_FORCE_INLINE int32_t get_k_min_sum(const uint8_t* mins, const int16_t* block_sums) noexcept {
+		int32_t sum{};
+		for (uint64_t sub = 0; sub < 8; ++sub) {
+			sum += mins[sub] * (block_sums[sub * 2] + block_sums[sub * 2 + 1]);
+		}
+		return sum;
+	}
+
+	// Sum of sub_scale * 32 * (sum of the activation quants) over one super-block; the offset term of q6_k.
+	RT_TM_FORCE_INLINE int32_t get_q6_k_offset_sum(const int8_t* scales, const int16_t* block_sums) noexcept {
+		int32_t sum{};
+		for (uint64_t sub = 0; sub < q_k_block_size / 16; ++sub) {
+			sum += scales[sub] * block_sums[sub];
+		}
+		return sum * 32;
+	}
+
+	RT_TM_INLINE void quantize_row_q8_k(const float* input, block_q8_k* output, uint64_t count) noexcept {
+		for (uint64_t block = 0; block < count / q_k_block_size; ++block) {
+			const float* values{ input + block * q_k_block_size };
+			float extreme{};
+			for (uint64_t x = 0; x < q_k_block_size; ++x) {
+				if (std::fabs(values[x]) > std::fabs(extreme)) {
+					extreme = values[x];
+				}
+			}
+			const float inverse_scale{ extreme != 0.0f ? -127.0f / extreme : 0.0f };
+			output[block].scale = inverse_scale != 0.0f ? 1.0f / inverse_scale : 0.0f;
+			for (uint64_t x = 0; x < q_k_block_size; ++x) {
+				output[block].quants[x] = static_cast<int8_t>(std::min(127.0f, std::round(values[x] * inverse_scale)));
+			}
+			for (uint64_t x = 0; x < q_k_block_size / 16; ++x) {
+				int32_t sum{};
+				for (uint64_t y = 0; y < 16; ++y) {
+					sum += output[block].quants[x * 16 + y];
+				}
+				output[block].block_sums[x] = static_cast<int16_t>(sum);
+			}
+		}
+	}
+
+	// Sub-block n of a q4_k/q5_k super-block lives in the low (even n) or high (odd n) nibbles of quants[32 * (n / 2)..].
+	RT_TM_INLINE void dequantize_row_q4_k(const block_q4_k* input, float* output, uint64_t count) noexcept {
+		for (uint64_t block = 0; block < count / q_k_block_size; ++block) {
+			uint8_t scales[16];
+			unpack_k_scales(input[block].scales, scales);
+			const float scale{ fp16_to_fp32(input[block].scale) };
+			const float min_scale{ fp16_to_fp32(input[block].min_scale) };
+			for (uint64_t sub = 0; sub < 8; ++sub) {
+				const uint8_t* quants{ input[block].quants + (sub / 2) * 32 };
+				for (uint64_t x = 0; x < 32; ++x) {
+					const int32_t value{ (quants[x] >> ((sub & 1) * 4)) & 0x0F };
+					output[block * q_k_block_size + sub * 32 + x] = scale * scales[sub] * static_cast<float>(value) - min_scale * scales[sub + 8];
+				}
+			}
+		}
+	}
+
+	// q5_k adds a fifth bit per element: bit n of high_bits[x] belongs to element x of sub-block n.
+	RT_TM_INLINE void dequantize_row_q5_k(const block_q5_k* input, float* output, uint64_t count) noexcept {
+		for (uint64_t block = 0; block < count / q_k_block_size; ++block) {
+			uint8_t scales[16];
+			unpack_k_scales(input[block].scales, scales);
+			const float scale{ fp16_to_fp32(input[block].scale) };
+			const float min_scale{ fp16_to_fp32(input[block].min_scale) };
+			for (uint64_t sub = 0; sub < 8; ++sub) {
+				const uint8_t* quants{ input[block].quants + (sub / 2) * 32 };
+				for (uint64_t x = 0; x < 32; ++x) {
+					const int32_t value{ ((quants[x] >> ((sub & 1) * 4)) & 0x0F) | (((input[block].high_bits[x] >> sub) & 1) << 4) };
+					output[block * q_k_block_size + sub * 32 + x] = scale * scales[sub] * static_cast<float>(value) - min_scale * scales[sub + 8];
+				}
+			}
+		}
+	}
+
+	// q6_k stores each 128-element half as four 32-element groups: group g takes the low (g < 2) or high nibbles of
+	// low_bits[32 * (g & 1)..] and bits 2g..2g+1 of high_bits, with an implicit offset of 32 and one scale per 16 elements.
+	RT_TM_FORCE_INLINE int32_t get_q6_k_value(const block_q6_k& block, uint64_t half, uint64_t group, uint64_t x) noexcept {
+		const uint8_t low{ static_cast<uint8_t>((block.low_bits[half * 64 + (group & 1) * 32 + x] >> ((group >> 1) * 4)) & 0x0F) };
+		const uint8_t high{ static_cast<uint8_t>((block.high_bits[half * 32 + x] >> (group * 2)) & 3) };
+		return static_cast<int32_t>(low | (high << 4)) - 32;
+	}
+
+	RT_TM_INLINE void dequantize_row_q6_k(const block_q6_k* input, float* output, uint64_t count) noexcept {
+		for (uint64_t block = 0; block < count / q_k_block_size; ++block) {
+			const float scale{ fp16_to_fp32(input[block].scale) };
+			for (uint64_t half = 0; half < 2; ++half) {
+				for (uint64_t group = 0; group < 4; ++group) {
+					for (uint64_t x = 0; x < 32; ++x) {
+						const int8_t sub_scale{ input[block].scales[half * 8 + group * 2 + x / 16] };
+						output[block * q_k_block_size + half * 128 + group * 32 + x] = scale * sub_scale * static_cast<float>(get_q6_k_value(input[block], half, group, x));
+					}
+				}
+			}
+		}
+	}
+
+	// Scalar references for the K-quant x q8_k dot products. Everything up to the super-block scales stays in integers.
+	RT_TM_INLINE float vec_dot_q4_k_q8_k(const block_q4_k* weights, const block_q8_k* activations, uint64_t block_count) noexcept {
+		float sum{};
+		for (uint64_t block = 0; block < block_count; ++block) {
+			uint8_t scales[16];
+			unpack_k_scales(weights[block].scales, scales);
+			int32_t scaled_sum{};
+			for (uint64_t sub = 0; sub < 8; ++sub) {
+				const uint8_t* quants{ weights[block].quants + (sub / 2) * 32 };
+				const int8_t* activation_quants{ activations[block].quants + sub * 32 };
+				int32_t dot{};
+				for (uint64_t x = 0; x < 32; ++x) {
+					dot += ((quants[x] >> ((sub & 1) * 4)) & 0x0F) * activation_quants[x];
+				}
+				scaled_sum += scales[sub] * dot;
+			}
+			const int32_t min_sum{ get_k_min_sum(scales + 8, activations[block].block_sums) };
+			sum += activations[block].scale *
+				(fp16_to_fp32(weights[block].scale) * static_cast<float>(scaled_sum) - fp16_to_fp32(weights[block].min_scale) * static_cast<float>(min_sum));
+		}
+		return sum;
+	}
+
+	RT_TM_INLINE float vec_dot_q5_k_q8_k(const block_q5_k* weights, const block_q8_k* activations, uint64_t block_count) noexcept {
+		float sum{};
+		for (uint64_t block = 0; block < block_count; ++block) {
+			uint8_t scales[16];
+			unpack_k_scales(weights[block].scales, scales);
+			int32_t scaled_sum{};
+			for (uint64_t sub = 0; sub < 8; ++sub) {
+				const uint8_t* quants{ weights[block].quants + (sub / 2) * 32 };
+				const int8_t* activation_quants{ activations[block].quants + sub * 32 };
+				int32_t dot{};
+				for (uint64_t x = 0; x < 32; ++x) {
+					dot += (((quants[x] >> ((sub & 1) * 4)) & 0x0F) | (((weights[block].high_bits[x] >> sub) & 1) << 4)) * activation_quants[x];
+				}
+				scaled_sum += scales[sub] * dot;
+			}
+			const int32_t min_sum{ get_k_min_sum(scales + 8, activations[block].block_sums) };
+			sum += activations[block].scale *
+				(fp16_to_fp32(weights[block].scale) * static_cast<float>(scaled_sum) - fp16_to_fp32(weights[block].min_scale) * static_cast<float>(min_sum));
+		}
+		return sum;
+	}
+
+	RT_TM_INLINE float vec_dot_q6_k_q8_k(const block_q6_k* weights, const block_q8_k* activations, uint64_t block_count) noexcept {
+		float sum{};
+		for (uint64_t block = 0; block < block_count; ++block) {
+			int32_t scaled_sum{};
+			for (uint64_t half = 0; half < 2; ++half) {
+				for (uint64_t group = 0; group < 4; ++group) {
+					const int8_t* activation_quants{ activations[block].quants + half * 128 + group * 32 };
+					for (uint64_t sub = 0; sub < 2; ++sub) {
+						int32_t dot{};
+						for (uint64_t x = sub * 16; x < sub * 16 + 16; ++x) {
+							dot += get_q6_k_value(weights[block], half, group, x) * activation_quants[x];
+						}
+						scaled_sum += weights[block].scales[half * 8 + group * 2 + sub] * dot;
+					}
+				}
+			}
+			sum += activations[block].scale * fp16_to_fp32(weights[block].scale) * static_cast<float>(scaled_sum);
+		}
+		return sum;
+	}
+
+	RT_TM_INLINE void matvec_q4_k(const block_q4_k* weights, const block_q8_k* activations, float* output, uint64_t row_count, uint64_t block_count) noexcept {
+		for (uint64_t row = 0; row < row_count; ++row) {
+			output[row] = vec_dot_q4_k_q8_k(weights + row * block_count, activations, block_count);
+		}
+	}
+
+	RT_TM_INLINE void matvec_q5_k(const block_q5_k* weights, const block_q8_k* activations, float* output, uint64_t row_count, uint64_t block_count) noexcept {
+		for (uint64_t row = 0; row < row_count; ++row) {
+			output[row] = vec_dot_q5_k_q8_k(weights + row * block_count, activations, block_count);
+		}
+	}
+
+	RT_TM_INLINE void matvec_q6_k(const block_q6_k* weights, const block_q8_k* activations, float* output, uint64_t row_count, uint64_t block_count) noexcept {
+		for (uint64_t row = 0; row < row_count; ++row) {
+			output[row] = vec_dot_q6_k_q8_k(weights + row * block_count, activations, block_count);
+		}
+	}
+
+	// Non-linear 4-bit codebook shared by iq4_nl and iq4_xs: each nibble indexes a value of this table instead of
+	// standing for an evenly spaced level.
+	inline static constexpr int8_t iq4_values[16]{ -127, -104, -83, -65, -49, -35, -22, -10, 1, 13, 25, 38, 53, 69, 89, 113 };
+
+	inline static constexpr uint64_t iq4_nl_block_size{ 32 };
+
+	// Same layout as block_q4_0: elements 0..15 in the low nibbles and 16..31 in the high nibbles.
+	struct block_iq4_nl {
+		uint16_t scale;
+		uint8_t quants[iq4_nl_block_size / 2];
+	};
+
+	// 256-element super-block of eight iq4_nl-style sub-blocks, each with a 6-bit scale stored as 4 low bits in
+	// low_scales and 2 high bits in high_scales, biased by 32.
+	struct block_iq4_xs {
+		uint16_t scale;
+		uint16_t high_scales;
+		uint8_t low_scales[q_k_block_size / 64];
+		uint8_t quants[q_k_block_size / 2];
+	};
+
+	static_assert(sizeof(block_iq4_nl) == get_data_type_traits(data_type::iq4_nl).type_size);
+	static_assert(sizeof(block_iq4_xs) == get_data_type_traits(data_type::iq4_xs).type_size);
+
+	RT_TM_FORCE_INLINE int32_t get_iq4_xs_scale(const block_iq4_xs& block, uint64_t sub) noexcept {
+		const int32_t low{ (block.low_scales[sub / 2] >> ((sub & 1) * 4)) & 0x0F };
+		const int32_t high{ (block.high_scales >> (sub * 2)) & 3 };
+		return (low | (high << 4)) - 32;
+	}
+
+	RT_TM_INLINE void dequantize_row_iq4_nl(const block_iq4_nl* input, float* output, uint64_t count) noexcept {
+		for (uint64_t block = 0; block < count / iq4_nl_block_size; ++block) {
+			const float scale{ fp16_to_fp32(input[block].scale) };
+			for (uint64_t x = 0; x < iq4_nl_block_size / 2; ++x) {
+				output[block * iq4_nl_block_size + x]						   = scale * static_cast<float>(iq4_values[input[block].quants[x] & 0x0F]);
+				output[block * iq4_nl_block_size + x + iq4_nl_block_size / 2] = scale * static_cast<float>(iq4_values[input[block].quants[x] >> 4]);
+			}
+		}
+	}
+
+	RT_TM_INLINE void dequantize_row_iq4_xs(const block_iq4_xs* input, float* output, uint64_t count) noexcept {
+		for (uint64_t block = 0; block < count / q_k_block_size; ++block) {
+			const float scale{ fp16_to_fp32(input[block].scale) };
+			for (uint64_t sub = 0; sub < 8; ++sub) {
+				const float sub_scale{ scale * static_cast<float>(get_iq4_xs_scale(input[block], sub)) };
+				const uint8_t* quants{ input[block].quants + sub * 16 };
+				float* values{ output + block * q_k_block_size + sub * 32 };
+				for (uint64_t x = 0; x < 16; ++x) {
+					values[x]	   = sub_scale * static_cast<float>(iq4_values[quants[x] & 0x0F]);
+					values[x + 16] = sub_scale * static_cast<float>(iq4_values[quants[x] >> 4]);
+				}
+			}
+		}
+	}
+
+	// Scalar references for the codebook dot products; iq4_nl pairs with q8_0 activations and iq4_xs with q8_k.
+	RT_TM_INLINE float vec_dot_iq4_nl_q8_0(const block_iq4_nl* weights, const block_q8_0* activations, uint64_t block_count) noexcept {
+		float sum{};
+		for (uint64_t block = 0; block < block_count; ++block) {
+			int32_t block_sum{};
+			for (uint64_t x = 0; x < iq4_nl_block_size / 2; ++x) {
+				block_sum += iq4_values[weights[block].quants[x] & 0x0F] * activations[block].quants[x];
+				block_sum += iq4_values[weights[block].quants[x] >> 4] * activations[block].quants[x + iq4_nl_block_size / 2];
+			}
+			sum += fp16_to_fp32(weights[block].scale) * fp16_to_fp32(activations[block].scale) * static_cast<float>(block_sum);
+		}
+		return sum;
+	}
+
+	RT_TM_INLINE float vec_dot_iq4_xs_q8_k(const block_iq4_xs* weights, const block_q8_k* activations, uint64_t block_count) noexcept {
+		float sum{};
+		for (uint64_t block = 0; block < block_count; ++block) {
+			int32_t scaled_sum{};
+			for (uint64_t sub = 0; sub < 8; ++sub) {
+				const uint8_t* quants{ weights[block].quants + sub * 16 };
+				const int8_t* activation_quants{ activations[block].quants + sub * 32 };
+				int32_t dot{};
+				for (uint64_t x = 0; x < 16; ++x) {
+					dot += iq4_values[quants[x] & 0x0F] * activation_quants[x];
+					dot += iq4_values[quants[x] >> 4] * activation_quants[x + 16];
+				}
+				scaled_sum += get_iq4_xs_scale(weights[block], sub) * dot;
+			}
+			sum += fp16_to_fp32(weights[block].scale) * activations[block].scale * static_cast<float>(scaled_sum);
+		}
+		return sum;
+	}
+
+	RT_TM_INLINE void matvec_iq4_nl(const block_iq4_nl* weights, const block_q8_0* activations, float* output, uint64_t row_count, uint64_t block_count) noexcept {
+		for (uint64_t row = 0; row < row_count; ++row) {
+			output[row] = vec_dot_iq4_nl_q8_0(weights + row * block_count, activations, block_count);
+		}
+	}
+
+	RT_TM_INLINE void matvec_iq4_xs(const block_iq4_xs* weights, const block_q8_k* activations, float* output, uint64_t row_count, uint64_t block_count) noexcept {
+		for (uint64_t row = 0; row < row_count; ++row) {
+			output[row] = vec_dot_iq4_xs_q8_k(weights + row * block_count, activations, block_count);
+		}
+	}
+
+}
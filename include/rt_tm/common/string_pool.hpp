@@ -0,0 +1,87 @@
+/*
+MIT License
+
+Copyright (c) 2025 RealTimeChris (Chris M)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "RT-TM Library"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+This file was independently created by RealTimeChris (Chris M), without reuse
+or derivation from any codebase owned by other entities, including any contract work.
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT
+OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#pragma once
+
+#include <rt_tm/common/common.hpp>
+#include <string_view>
+#include <stdexcept>
+#include <limits>
+#include <vector>
+
+namespace rt_tm {
+
+	// Contiguous pool of strings: one character buffer plus an offset table, so a whole vocabulary costs two allocations.
+	struct string_pool {
+		RT_TM_FORCE_INLINE void reserve(size_t string_count, size_t byte_count) {
+			if (byte_count > std::numeric_limits<uint32_t>::max()) {
+				throw std::runtime_error{ "Sorry, but that string_pool would exceed 4 GiB!" };
+			}
+			offsets.reserve(string_count + 1);
+			characters.reserve(byte_count);
+		}
+
+		RT_TM_FORCE_INLINE void emplace_back(std::string_view value) {
+			if (characters.size() + value.size() > std::numeric_limits<uint32_t>::max()) {
+				throw std::runtime_error{ "Sorry, but that string_pool would exceed 4 GiB!" };
+			}
+			if (offsets.empty()) {
+				offsets.emplace_back(0);
+			}
+			characters.insert(characters.end(), value.begin(), value.end());
+			offsets.emplace_back(static_cast<uint32_t>(characters.size()));
+		}
+
+		RT_TM_FORCE_INLINE std::string_view operator[](size_t index) const noexcept {
+			return { characters.data() + offsets[index], offsets[index + 1] - offsets[index] };
+		}
+
+		RT_TM_FORCE_INLINE size_t size() const noexcept {
+			return offsets.empty() ? 0 : offsets.size() - 1;
+		}
+
+		RT_TM_FORCE_INLINE bool empty() const noexcept {
+			return size() == 0;
+		}
+
+		RT_TM_FORCE_INLINE const char* data() const noexcept {
+			return characters.data();
+		}
+
+		RT_TM_FORCE_INLINE size_t byte_size() const noexcept {
+			return characters.size();
+		}
+
+		RT_TM_FORCE_INLINE void clear() noexcept {
+			offsets.clear();
+			characters.clear();
+		}
+
+	  protected:
+		std::vector<uint32_t> offsets{};
+		std::vector<char> characters{};
+	};
+
+}
@@ -0,0 +1,142 @@
+/*
+MIT License
+
+Copyright (c) 2025 RealTimeChris (Chris M)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "RT-TM Library"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+This file was independently created by RealTimeChris (Chris M), without reuse
+or derivation from any codebase owned by other entities, including any contract work.
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT
+OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#pragma once
+
+#include <rt_tm/common/common.hpp>
+#include <rt_tm/common/array.hpp>
+#include <chrono>
+#include <vector>
+
+namespace rt_tm {
+
+	enum class load_phase : uint64_t {
+		header		 = 0,
+		kv_decode	 = 1,
+		tensor_infos = 2,
+		tokenizer	 = 3,
+		hparams		 = 4,
+		count,
+	};
+
+	struct phase_telemetry {
+		uint64_t nanoseconds{};
+		uint64_t bytes{};
+	};
+
+	struct load_telemetry {
+		array<phase_telemetry, static_cast<size_t>(load_phase::count)> phases{};
+
+		RT_TM_FORCE_INLINE phase_telemetry& operator[](load_phase phase) noexcept {
+			return phases[static_cast<size_t>(phase)];
+		}
+
+		RT_TM_FORCE_INLINE const phase_telemetry& operator[](load_phase phase) const noexcept {
+			return phases[static_cast<size_t>(phase)];
+		}
+
+		RT_TM_FORCE_INLINE uint64_t total_nanoseconds() const noexcept {
+			uint64_t return_value{};
+			for (size_t x = 0; x < phases.size(); ++x) {
+				return_value += phases[x].nanoseconds;
+			}
+			return return_value;
+		}
+	};
+
+	struct warm_up_telemetry {
+		double gigabytes_per_second{};
+		uint64_t thread_count{};
+		uint64_t nanoseconds{};
+		uint64_t bytes{};
+	};
+
+	struct residency_telemetry {
+		uint64_t pages_succeeded{};
+		uint64_t pages_requested{};
+		uint64_t page_size{};
+		uint64_t bytes{};
+	};
+
+	struct numa_telemetry {
+		uint64_t bytes_replicated{};
+		uint64_t bytes_split{};
+		uint64_t pages_requested{};
+		uint64_t pages_bound{};
+		uint64_t node_count{};
+	};
+
+	struct scratch_memory {
+		uint64_t capacity_bytes{};
+		uint64_t high_water_bytes{};
+	};
+
+	struct graph_memory_report {
+		std::vector<scratch_memory> scratch{};
+		uint64_t activation_planned_bytes{};
+		uint64_t activation_naive_bytes{};
+	};
+
+	struct prefix_cache_telemetry {
+		uint64_t looked_up_tokens{};
+		uint64_t cached_blocks{};
+		uint64_t saved_tokens{};
+		uint64_t lookups{};
+		uint64_t hits{};
+
+		RT_TM_FORCE_INLINE double hit_rate() const noexcept {
+			return lookups ? static_cast<double>(hits) / static_cast<double>(lookups) : 0.0;
+		}
+	};
+
+	struct weight_cache_telemetry {
+		uint64_t nanoseconds{};
+		uint64_t bytes{};
+		bool cache_hit{};
+	};
+
+	template<bool enabled> struct phase_timer {
+		RT_TM_FORCE_INLINE phase_timer(phase_telemetry& phase_new) noexcept : phase{ phase_new }, start{ std::chrono::steady_clock::now() } {
+		}
+
+		RT_TM_FORCE_INLINE void stop(uint64_t bytes) noexcept {
+			phase.nanoseconds += static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+			phase.bytes += bytes;
+		}
+
+	  protected:
+		phase_telemetry& phase;
+		std::chrono::steady_clock::time_point start{};
+	};
+
+	template<> struct phase_timer<false> {
+		RT_TM_FORCE_INLINE constexpr phase_timer(phase_telemetry&) noexcept {
+		}
+
+		RT_TM_FORCE_INLINE constexpr void stop(uint64_t) noexcept {
+		}
+	};
+
+}
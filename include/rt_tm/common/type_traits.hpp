@@ -24,3 +24,111 @@ OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
 OR OTHER DEALINGS IN THE SOFTWARE.
 */
 #pragma once
+
+#include <rt_tm/common/common.hpp>
+
+namespace rt_tm {
+
+	struct data_type_traits {
+		uint64_t block_size{};
+		uint64_t type_size{};
+	};
+
+	RT_TM_FORCE_INLINE constexpr data_type_traits get_data_type_traits(data_type type) noexcept {
+		switch (type) {
+			case data_type::float_32: {
+				return { 1, 4 };
+			}
+			case data_type::float_16: {
+				return { 1, 2 };
+			}
+			case data_type::q4_0: {
+				return { 32, 18 };
+			}
+			case data_type::q4_1: {
+				return { 32, 20 };
+			}
+			case data_type::q5_0: {
+				return { 32, 22 };
+			}
+			case data_type::q5_1: {
+				return { 32, 24 };
+			}
+			case data_type::q8_0: {
+				return { 32, 34 };
+			}
+			case data_type::q8_1: {
+				return { 32, 36 };
+			}
+			case data_type::q2_k: {
+				return { 256, 84 };
+			}
+			case data_type::q3_k: {
+				return { 256, 110 };
+			}
+			case data_type::q4_k: {
+				return { 256, 144 };
+			}
+			case data_type::q5_k: {
+				return { 256, 176 };
+			}
+			case data_type::q6_k: {
+				return { 256, 210 };
+			}
+			case data_type::q8_k: {
+				return { 256, 292 };
+			}
+			case data_type::iq2_xxs: {
+				return { 256, 66 };
+			}
+			case data_type::iq2_xs: {
+				return { 256, 74 };
+			}
+			case data_type::iq3_xxs: {
+				return { 256, 98 };
+			}
+			case data_type::iq1_s: {
+				return { 256, 50 };
+			}
+			case data_type::iq4_nl: {
+				return { 32, 18 };
+			}
+			case data_type::iq3_s: {
+				return { 256, 110 };
+			}
+			case data_type::iq2_s: {
+				return { 256, 82 };
+			}
+			case data_type::iq4_xs: {
+				return { 256, 136 };
+			}
+			case data_type::int_8: {
+				return { 1, 1 };
+			}
+			case data_type::int_16: {
+				return { 1, 2 };
+			}
+			case data_type::int_32: {
+				return { 1, 4 };
+			}
+			case data_type::int_64: {
+				return { 1, 8 };
+			}
+			case data_type::float_64: {
+				return { 1, 8 };
+			}
+			case data_type::iqq_m: {
+				return { 256, 56 };
+			}
+			default: {
+				return {};
+			}
+		}
+	}
+
+	RT_TM_FORCE_INLINE constexpr uint64_t get_row_size(data_type type, uint64_t element_count) noexcept {
+		const data_type_traits traits{ get_data_type_traits(type) };
+		return traits.block_size ? (element_count / traits.block_size) * traits.type_size : 0;
+	}
+
+}
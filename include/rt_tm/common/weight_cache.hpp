@@ -0,0 +1,241 @@
+/*
+MIT License
+
+Copyright (c) 2025 RealTimeChris (Chris M)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "RT-TM Library"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+This file was independently created by RealTimeChris (Chris M), without reuse
+or derivation from any codebase owned by other entities, including any contract work.
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT
+OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#pragma once
+
+#include <rt_tm/common/model_graph.hpp>
+#include <rt_tm/common/debugging_io.hpp>
+#include <rt_tm/common/telemetry.hpp>
+#include <rt_tm/common/allocator.hpp>
+#include <rt_tm/cpu/cpu_kernels.hpp>
+#include <rt_tm/cpu/detect_isa.hpp>
+#include <filesystem>
+#include <algorithm>
+#include <fstream>
+#include <cstring>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace rt_tm {
+
+	// Converts a tensor from its GGUF layout into the layout the kernels of one SIMD tier consume. Whenever the output
+	// changes layout_version must be bumped, which invalidates every cache written before.
+	// Version 2 interleaves the blocks of q8_0 matrices gemm_tile_rows rows at a time, matching the register tile of
+	// that tier's kernels, and pads the row count to whole tiles with zero blocks.
+	template<size_t cpu_index> struct weight_packer {
+		inline static constexpr uint32_t layout_version{ 2 };
+		inline static constexpr uint64_t tile_rows{ cpu_kernels<cpu_index>::gemm_tile_rows };
+
+		// The token embedding is gathered row by row rather than multiplied, so it keeps the GGUF layout.
+		RT_TM_FORCE_INLINE static uint32_t get_interleaved_rows(const model_core& core) noexcept {
+			const bool is_matrix{ core.n_dimensions == 2 && core.dimensions[2] == 1 && core.dimensions[3] == 1 && core.name != "token_embd.weight" };
+			return tile_rows > 1 && core.type == data_type::q8_0 && is_matrix && core.dimensions[0] % q8_0_block_size == 0 ? static_cast<uint32_t>(tile_rows) : 1;
+		}
+
+		RT_TM_FORCE_INLINE static uint64_t packed_size(const model_core& core) noexcept {
+			const uint64_t interleaved_rows{ get_interleaved_rows(core) };
+			return interleaved_rows > 1 ? roundUpToMultiple(core.dimensions[1], interleaved_rows) * core.strides[1] : core.byte_size;
+		}
+
+		RT_TM_FORCE_INLINE static void pack(const model_core& core, void* dst) noexcept {
+			const uint64_t interleaved_rows{ get_interleaved_rows(core) };
+			if (interleaved_rows > 1) {
+				const uint64_t block_count{ core.dimensions[0] / q8_0_block_size };
+				pack_weight_panel(static_cast<const block_q8_0*>(core.data), core.dimensions[1], block_count, 0, block_count, interleaved_rows, static_cast<block_q8_0*>(dst));
+			} else {
+				std::memcpy(dst, core.data, core.byte_size);
+			}
+		}
+	};
+
+	inline static constexpr uint64_t weight_cache_magic{ 0x3148434143545452ull };
+	inline static constexpr uint64_t weight_cache_data_alignment{ 4096 };
+	inline static constexpr uint64_t weight_cache_tensor_alignment{ 64 };
+
+	struct weight_cache_header {
+		uint64_t magic{ weight_cache_magic };
+		uint32_t layout_version{};
+		uint32_t cpu_arch_index{};
+		uint64_t model_hash{};
+		uint64_t tensor_count{};
+		uint64_t data_offset{};
+	};
+
+	struct weight_cache_entry {
+		uint64_t offset{};
+		uint64_t byte_size{};
+	};
+
+	// Stores every tensor of a model_graph in its final execution layout. The first start packs and writes the file,
+	// later starts map it and rebind the model_cores to it; a different GGUF, ISA tier or layout version rebuilds it.
+	template<global_config config> struct weight_cache {
+		RT_TM_INLINE static weight_cache_telemetry load_or_create(model_graph& graph, const std::filesystem::path& path) {
+			switch (cpu_arch_index_holder::cpu_arch_index) {
+				case 0: {
+					return load_or_create_impl<0>(graph, path);
+				}
+				case 1: {
+					return load_or_create_impl<1>(graph, path);
+				}
+				case 2: {
+					return load_or_create_impl<2>(graph, path);
+				}
+				default: {
+					return {};
+				}
+			}
+		}
+
+	  protected:
+		template<size_t cpu_index> RT_TM_INLINE static weight_cache_telemetry load_or_create_impl(model_graph& graph, const std::filesystem::path& path) {
+			const auto start = std::chrono::steady_clock::now();
+			weight_cache_telemetry return_value{};
+			const weight_cache_header expected{ .layout_version = weight_packer<cpu_index>::layout_version,
+				.cpu_arch_index								   = static_cast<uint32_t>(cpu_index),
+				.model_hash									   = graph.model_hash,
+				.tensor_count								   = graph.model_cores.size() };
+			std::error_code error_code{};
+			if (std::filesystem::exists(path, error_code)) {
+				return_value.cache_hit = bind<cpu_index>(graph, path, expected, return_value);
+			}
+			bool bound{ return_value.cache_hit };
+			if (!bound && is_packed(graph)) {
+				if constexpr (config.exceptions) {
+					throw std::runtime_error{ "Sorry, but that graph is already bound to a weight cache, so it cannot be packed again: " + path.string() };
+				} else {
+					std::cerr << "Sorry, but that graph is already bound to a weight cache, so it cannot be packed again: " + path.string() << std::endl;
+					return return_value;
+				}
+			}
+			if (!bound) {
+				bound = create<cpu_index>(graph, path, expected) && bind<cpu_index>(graph, path, expected, return_value);
+				if (!bound) {
+					if constexpr (config.exceptions) {
+						throw std::runtime_error{ "Failed to create the weight cache: " + path.string() };
+					} else {
+						std::cerr << "Failed to create the weight cache: " + path.string() << std::endl;
+					}
+				}
+			}
+			// Binding points the views at the cache mapping, so placement or residency set up while parsing is redone
+			// against it; the superseded copies are released when their handles are replaced.
+			if (bound) {
+				if constexpr (config.numa) {
+					graph.numa = graph.place_numa(numa_topology::detect());
+				} else if constexpr (config.residency != residency_mode::none) {
+					graph.residency = graph.make_resident(config.residency);
+				}
+			}
+			return_value.nanoseconds = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+			return return_value;
+		}
+
+		// Cores rebound to a cache already hold the packed layout; packing them again would interleave them twice.
+		RT_TM_FORCE_INLINE static bool is_packed(const model_graph& graph) noexcept {
+			return std::any_of(graph.model_cores.begin(), graph.model_cores.end(), [](const model_core& core) {
+				return core.interleaved_rows > 1;
+			});
+		}
+
+		template<size_t cpu_index> RT_TM_INLINE static bool bind(model_graph& graph, const std::filesystem::path& path, const weight_cache_header& expected,
+			weight_cache_telemetry& telemetry) {
+			auto file = std::make_shared<memory_mapped_file<false>>(path);
+			if (file->size() < sizeof(weight_cache_header)) {
+				return false;
+			}
+			weight_cache_header header{};
+			std::memcpy(&header, file->data(), sizeof(header));
+			if (header.magic != expected.magic || header.layout_version != expected.layout_version || header.cpu_arch_index != expected.cpu_arch_index ||
+				header.model_hash != expected.model_hash || header.tensor_count != expected.tensor_count || header.data_offset > file->size() ||
+				sizeof(weight_cache_header) + header.tensor_count * sizeof(weight_cache_entry) > header.data_offset) {
+				return false;
+			}
+			const char* entries{ file->data() + sizeof(weight_cache_header) };
+			for (uint64_t x = 0; x < header.tensor_count; ++x) {
+				weight_cache_entry entry{};
+				std::memcpy(&entry, entries + x * sizeof(weight_cache_entry), sizeof(entry));
+				if (entry.byte_size != weight_packer<cpu_index>::packed_size(graph.model_cores[x]) || entry.byte_size > file->size() ||
+					entry.offset > file->size() - entry.byte_size) {
+					return false;
+				}
+			}
+			for (uint64_t x = 0; x < header.tensor_count; ++x) {
+				weight_cache_entry entry{};
+				std::memcpy(&entry, entries + x * sizeof(weight_cache_entry), sizeof(entry));
+				graph.model_cores[x].interleaved_rows = weight_packer<cpu_index>::get_interleaved_rows(graph.model_cores[x]);
+				graph.model_cores[x].data			  = file->data() + entry.offset;
+				graph.model_cores[x].byte_size		  = entry.byte_size;
+			}
+			telemetry.bytes = file->size();
+			graph.file_handles.emplace_back(std::move(file));
+			return true;
+		}
+
+		// Packs and writes one tensor at a time, so only the largest interleaved tensor is ever held in memory. The file is
+		// written under a temporary name and only renamed into place once every byte reached the disk.
+		template<size_t cpu_index> RT_TM_INLINE static bool create(const model_graph& graph, const std::filesystem::path& path, weight_cache_header header) {
+			static constexpr char padding[weight_cache_data_alignment]{};
+			uint64_t offset{ sizeof(weight_cache_header) + graph.model_cores.size() * sizeof(weight_cache_entry) };
+			header.data_offset = (offset + weight_cache_data_alignment - 1) & ~(weight_cache_data_alignment - 1);
+			offset			   = header.data_offset;
+			std::vector<weight_cache_entry> entries(graph.model_cores.size());
+			for (size_t x = 0; x < graph.model_cores.size(); ++x) {
+				entries[x].offset	 = offset;
+				entries[x].byte_size = weight_packer<cpu_index>::packed_size(graph.model_cores[x]);
+				offset				 = (offset + entries[x].byte_size + weight_cache_tensor_alignment - 1) & ~(weight_cache_tensor_alignment - 1);
+			}
+			std::filesystem::path temp_path{ path };
+			temp_path += ".tmp";
+			std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+			file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+			file.write(reinterpret_cast<const char*>(entries.data()), static_cast<std::streamsize>(entries.size() * sizeof(weight_cache_entry)));
+			uint64_t written{ sizeof(header) + entries.size() * sizeof(weight_cache_entry) };
+			std::vector<char, alloc_wrapper<char>> buffer{};
+			for (size_t x = 0; x < graph.model_cores.size() && file; ++x) {
+				const model_core& core{ graph.model_cores[x] };
+				file.write(padding, static_cast<std::streamsize>(entries[x].offset - written));
+				if (weight_packer<cpu_index>::get_interleaved_rows(core) > 1) {
+					buffer.resize(entries[x].byte_size);
+					weight_packer<cpu_index>::pack(core, buffer.data());
+					file.write(buffer.data(), static_cast<std::streamsize>(entries[x].byte_size));
+				} else {
+					file.write(static_cast<const char*>(core.data), static_cast<std::streamsize>(entries[x].byte_size));
+				}
+				written = entries[x].offset + entries[x].byte_size;
+			}
+			file.close();
+			std::error_code error_code{};
+			if (!file) {
+				std::filesystem::remove(temp_path, error_code);
+				return false;
+			}
+			std::filesystem::rename(temp_path, path, error_code);
+			return !error_code;
+		}
+	};
+
+}
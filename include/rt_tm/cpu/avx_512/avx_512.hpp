@@ -0,0 +1,72 @@
+/*
+MIT License
+
+Copyright (c) 2025 RealTimeChris (Chris M)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "RT-TM Library"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+This file was independently created by RealTimeChris (Chris M), without reuse
+or derivation from any codebase owned by other entities, including any contract work.
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT
+OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#pragma once
+
+#include <rt_tm/common/quantization.hpp>
+#include <rt_tm/cpu/cpu_gemm.hpp>
+#include <cstdint>
+
+namespace rt_tm::avx_512 {
+
+	float vec_dot_q8_0_q8_0(const block_q8_0* weights, const block_q8_0* activations, uint64_t block_count) noexcept;
+
+	void matvec_q8_0(const block_q8_0* weights, const block_q8_0* activations, float* output, uint64_t row_count, uint64_t block_count) noexcept;
+
+	float vec_dot_q4_k_q8_k(const block_q4_k* weights, const block_q8_k* activations, uint64_t block_count) noexcept;
+
+	float vec_dot_q5_k_q8_k(const block_q5_k* weights, const block_q8_k* activations, uint64_t block_count) noexcept;
+
+	float vec_dot_q6_k_q8_k(const block_q6_k* weights, const block_q8_k* activations, uint64_t block_count) noexcept;
+
+	void matvec_q4_k(const block_q4_k* weights, const block_q8_k* activations, float* output, uint64_t row_count, uint64_t block_count) noexcept;
+
+	void matvec_q5_k(const block_q5_k* weights, const block_q8_k* activations, float* output, uint64_t row_count, uint64_t block_count) noexcept;
+
+	void matvec_q6_k(const block_q6_k* weights, const block_q8_k* activations, float* output, uint64_t row_count, uint64_t block_count) noexcept;
+
+	// Sixteen zmm accumulators, each covering two column blocks at a time.
+	inline static constexpr uint64_t gemm_tile_rows{ 4 };
+	inline static constexpr uint64_t gemm_tile_tokens{ 4 };
+
+	// Same contract as avx_2::gemm_q8_0; uses vpdpbusd when the CPU has AVX512-VNNI.
+	void gemm_q8_0(const block_q8_0* weights, const block_q8_0* activations, float* output, uint64_t row_count, uint64_t token_count, uint64_t block_count,
+		uint64_t output_stride, const gemm_blocking& blocking, block_q8_0* panel) noexcept;
+
+	// Variants over weights interleaved by weight_packer, gemm_tile_rows rows per tile.
+	void gemm_q8_0_interleaved(const block_q8_0* weights, const block_q8_0* activations, float* output, uint64_t row_count, uint64_t token_count,
+		uint64_t block_count, uint64_t output_stride, const gemm_blocking& blocking) noexcept;
+
+	void matvec_q8_0_interleaved(const block_q8_0* weights, const block_q8_0* activations, float* output, uint64_t row_count, uint64_t block_count) noexcept;
+
+	float vec_dot_iq4_nl_q8_0(const block_iq4_nl* weights, const block_q8_0* activations, uint64_t block_count) noexcept;
+
+	float vec_dot_iq4_xs_q8_k(const block_iq4_xs* weights, const block_q8_k* activations, uint64_t block_count) noexcept;
+
+	void matvec_iq4_nl(const block_iq4_nl* weights, const block_q8_0* activations, float* output, uint64_t row_count, uint64_t block_count) noexcept;
+
+	void matvec_iq4_xs(const block_iq4_xs* weights, const block_q8_k* activations, float* output, uint64_t row_count, uint64_t block_count) noexcept;
+
+}
@@ -0,0 +1,69 @@
+/*
+MIT License
+
+Copyright (c) 2025 RealTimeChris (Chris M)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "RT-TM Library"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+This file was independently created by RealTimeChris (Chris M), without reuse
+or derivation from any codebase owned by other entities, including any contract work.
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT
+OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#pragma once
+
+#include <rt_tm/cpu/detect_isa.hpp>
+#include <algorithm>
+#include <cstdint>
+
+namespace rt_tm {
+
+	// Loop blocking for the quantized GEMMs, in the spirit of GotoBLAS: column_blocks quant blocks of a register tile's
+	// weight rows and token rows fit in half of L1, a packed panel of row_block weight rows fits in half of L2, and the
+	// activation slices of token_block tokens fit in half of L3.
+	struct gemm_blocking {
+		uint64_t column_blocks{};
+		uint64_t row_block{};
+		uint64_t token_block{};
+	};
+
+	RT_TM_INLINE gemm_blocking get_gemm_blocking(const cache_sizes& sizes, uint64_t tile_rows, uint64_t tile_tokens, uint64_t block_bytes) noexcept {
+		gemm_blocking blocking{};
+		blocking.column_blocks = std::max<uint64_t>((sizes.l1_data / 2) / ((tile_rows + tile_tokens) * block_bytes) & ~uint64_t{ 1 }, 2);
+		blocking.row_block	   = std::max<uint64_t>((sizes.l2 / 2) / (blocking.column_blocks * block_bytes) / tile_rows * tile_rows, tile_rows);
+		blocking.token_block   = std::max<uint64_t>((sizes.l3 / 2) / (blocking.column_blocks * block_bytes) / tile_tokens * tile_tokens, tile_tokens);
+		return blocking;
+	}
+
+	// Copies column blocks [column_block, column_block + column_count) of row_count weight rows into tiles of tile_rows
+	// rows each, with the tile's blocks interleaved per column: panel[(tile * column_count + column) * tile_rows + row].
+	// Rows past row_count in the last tile are zero blocks, so the micro-kernels never need a row remainder path.
+	template<typename block_type> RT_TM_INLINE void pack_weight_panel(const block_type* weights, uint64_t row_count, uint64_t block_count, uint64_t column_block,
+		uint64_t column_count, uint64_t tile_rows, block_type* panel) noexcept {
+		for (uint64_t tile = 0; tile * tile_rows < row_count; ++tile) {
+			for (uint64_t column = 0; column < column_count; ++column) {
+				for (uint64_t row = 0; row < tile_rows; ++row) {
+					const uint64_t source_row{ tile * tile_rows + row };
+					panel[(tile * column_count + column) * tile_rows + row] = source_row < row_count ? weights[source_row * block_count + column_block + column] : block_type{};
+				}
+			}
+		}
+	}
+
+	// Below this many tokens the weights are streamed once per token by the matvec kernels instead.
+	inline static constexpr uint64_t gemm_min_tokens{ 8 };
+
+}
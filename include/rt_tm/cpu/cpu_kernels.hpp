@@ -0,0 +1,321 @@
+/*
+MIT License
+
+Copyright (c) 2025 RealTimeChris (Chris M)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "RT-TM Library"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+This file was independently created by RealTimeChris (Chris M), without reuse
+or derivation from any codebase owned by other entities, including any contract work.
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT
+OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#pragma once
+
+#include <rt_tm/common/quantization.hpp>
+#include <rt_tm/cpu/cpu_op_core.hpp>
+#include <rt_tm/cpu/cpu_gemm.hpp>
+#include <rt_tm/common/config.hpp>
+#if defined(RT_TM_ARCH_X86_64)
+	#include <rt_tm/cpu/avx_2/avx_2.hpp>
+	#include <rt_tm/cpu/avx_512/avx_512.hpp>
+#endif
+#include <algorithm>
+#include <stdexcept>
+#include <cstdint>
+
+namespace rt_tm {
+
+	// Kernel table per cpu_arch_index. Tiers without a variant library of their own fall back to the scalar references.
+	template<size_t cpu_index> struct cpu_kernels {
+		inline static constexpr uint64_t gemm_tile_rows{ 1 };
+		inline static constexpr uint64_t gemm_tile_tokens{ 1 };
+
+		RT_TM_FORCE_INLINE static float vec_dot_q8_0_q8_0(const block_q8_0* weights, const block_q8_0* activations, uint64_t block_count) noexcept {
+			return rt_tm::vec_dot_q8_0_q8_0(weights, activations, block_count);
+		}
+
+		RT_TM_FORCE_INLINE static void matvec_q8_0(const block_q8_0* weights, const block_q8_0* activations, float* output, uint64_t row_count, uint64_t block_count) noexcept {
+			rt_tm::matvec_q8_0(weights, activations, output, row_count, block_count);
+		}
+
+		RT_TM_FORCE_INLINE static float vec_dot_q4_k_q8_k(const block_q4_k* weights, const block_q8_k* activations, uint64_t block_count) noexcept {
+			return rt_tm::vec_dot_q4_k_q8_k(weights, activations, block_count);
+		}
+
+		RT_TM_FORCE_INLINE static float vec_dot_q5_k_q8_k(const block_q5_k* weights, const block_q8_k* activations, uint64_t block_count) noexcept {
+			return rt_tm::vec_dot_q5_k_q8_k(weights, activations, block_count);
+		}
+
+		RT_TM_FORCE_INLINE static float vec_dot_q6_k_q8_k(const block_q6_k* weights, const block_q8_k* activations, uint64_t block_count) noexcept {
+			return rt_tm::vec_dot_q6_k_q8_k(weights, activations, block_count);
+		}
+
+		RT_TM_FORCE_INLINE static void matvec_q4_k(const block_q4_k* weights, const block_q8_k* activations, float* output, uint64_t row_count, uint64_t block_count) noexcept {
+			rt_tm::matvec_q4_k(weights, activations, output, row_count, block_count);
+		}
+
+		RT_TM_FORCE_INLINE static void matvec_q5_k(const block_q5_k* weights, const block_q8_k* activations, float* output, uint64_t row_count, uint64_t block_count) noexcept {
+			rt_tm::matvec_q5_k(weights, activations, output, row_count, block_count);
+		}
+
+		RT_TM_FORCE_INLINE static void matvec_q6_k(const block_q6_k* weights, const block_q8_k* activations, float* output, uint64_t row_count, uint64_t block_count) noexcept {
+			rt_tm::matvec_q6_k(weights, activations, output, row_count, block_count);
+		}
+
+		RT_TM_FORCE_INLINE static float vec_dot_iq4_nl_q8_0(const block_iq4_nl* weights, const block_q8_0* activations, uint64_t block_count) noexcept {
+			return rt_tm::vec_dot_iq4_nl_q8_0(weights, activations, block_count);
+		}
+
+		RT_TM_FORCE_INLINE static float vec_dot_iq4_xs_q8_k(const block_iq4_xs* weights, const block_q8_k* activations, uint64_t block_count) noexcept {
+			return rt_tm::vec_dot_iq4_xs_q8_k(weights, activations, block_count);
+		}
+
+		RT_TM_FORCE_INLINE static void matvec_iq4_nl(const block_iq4_nl* weights, const block_q8_0* activations, float* output, uint64_t row_count, uint64_t block_count) noexcept {
+			rt_tm::matvec_iq4_nl(weights, activations, output, row_count, block_count);
+		}
+
+		RT_TM_FORCE_INLINE static void matvec_iq4_xs(const block_iq4_xs* weights, const block_q8_k* activations, float* output, uint64_t row_count, uint64_t block_count) noexcept {
+			rt_tm::matvec_iq4_xs(weights, activations, output, row_count, block_count);
+		}
+
+		RT_TM_FORCE_INLINE static void gemm_q8_0(const block_q8_0* weights, const block_q8_0* activations, float* output, uint64_t row_count, uint64_t token_count,
+			uint64_t block_count, uint64_t output_stride, const gemm_blocking&, block_q8_0*) noexcept {
+			for (uint64_t token = 0; token < token_count; ++token) {
+				rt_tm::matvec_q8_0(weights, activations + token * block_count, output + token * output_stride, row_count, block_count);
+			}
+		}
+	};
+
+#if defined(RT_TM_ARCH_X86_64)
+
+	template<> struct cpu_kernels<1> {
+		inline static constexpr uint64_t gemm_tile_rows{ avx_2::gemm_tile_rows };
+		inline static constexpr uint64_t gemm_tile_tokens{ avx_2::gemm_tile_tokens };
+
+		RT_TM_FORCE_INLINE static float vec_dot_q8_0_q8_0(const block_q8_0* weights, const block_q8_0* activations, uint64_t block_count) noexcept {
+			return avx_2::vec_dot_q8_0_q8_0(weights, activations, block_count);
+		}
+
+		RT_TM_FORCE_INLINE static void matvec_q8_0(const block_q8_0* weights, const block_q8_0* activations, float* output, uint64_t row_count, uint64_t block_count) noexcept {
+			avx_2::matvec_q8_0(weights, activations, output, row_count, block_count);
+		}
+
+		RT_TM_FORCE_INLINE static float vec_dot_q4_k_q8_k(const block_q4_k* weights, const block_q8_k* activations, uint64_t block_count) noexcept {
+			return avx_2::vec_dot_q4_k_q8_k(weights, activations, block_count);
+		}
+
+		RT_TM_FORCE_INLINE static float vec_dot_q5_k_q8_k(const block_q5_k* weights, const block_q8_k* activations, uint64_t block_count) noexcept {
+			return avx_2::vec_dot_q5_k_q8_k(weights, activations, block_count);
+		}
+
+		RT_TM_FORCE_INLINE static float vec_dot_q6_k_q8_k(const block_q6_k* weights, const block_q8_k* activations, uint64_t block_count) noexcept {
+			return avx_2::vec_dot_q6_k_q8_k(weights, activations, block_count);
+		}
+
+		RT_TM_FORCE_INLINE static void matvec_q4_k(const block_q4_k* weights, const block_q8_k* activations, float* output, uint64_t row_count, uint64_t block_count) noexcept {
+			avx_2::matvec_q4_k(weights, activations, output, row_count, block_count);
+		}
+
+		RT_TM_FORCE_INLINE static void matvec_q5_k(const block_q5_k* weights, const block_q8_k* activations, float* output, uint64_t row_count, uint64_t block_count) noexcept {
+			avx_2::matvec_q5_k(weights, activations, output, row_count, block_count);
+		}
+
+		RT_TM_FORCE_INLINE static void matvec_q6_k(const block_q6_k* weights, const block_q8_k* activations, float* output, uint64_t row_count, uint64_t block_count) noexcept {
+			avx_2::matvec_q6_k(weights, activations, output, row_count, block_count);
+		}
+
+		RT_TM_FORCE_INLINE static float vec_dot_iq4_nl_q8_0(const block_iq4_nl* weights, const block_q8_0* activations, uint64_t block_count) noexcept {
+			return avx_2::vec_dot_iq4_nl_q8_0(weights, activations, block_count);
+		}
+
+		RT_TM_FORCE_INLINE static float vec_dot_iq4_xs_q8_k(const block_iq4_xs* weights, const block_q8_k* activations, uint64_t block_count) noexcept {
+			return avx_2::vec_dot_iq4_xs_q8_k(weights, activations, block_count);
+		}
+
+		RT_TM_FORCE_INLINE static void matvec_iq4_nl(const block_iq4_nl* weights, const block_q8_0* activations, float* output, uint64_t row_count, uint64_t block_count) noexcept {
+			avx_2::matvec_iq4_nl(weights, activations, output, row_count, block_count);
+		}
+
+		RT_TM_FORCE_INLINE static void matvec_iq4_xs(const block_iq4_xs* weights, const block_q8_k* activations, float* output, uint64_t row_count, uint64_t block_count) noexcept {
+			avx_2::matvec_iq4_xs(weights, activations, output, row_count, block_count);
+		}
+
+		RT_TM_FORCE_INLINE static void gemm_q8_0(const block_q8_0* weights, const block_q8_0* activations, float* output, uint64_t row_count, uint64_t token_count,
+			uint64_t block_count, uint64_t output_stride, const gemm_blocking& blocking, block_q8_0* panel) noexcept {
+			avx_2::gemm_q8_0(weights, activations, output, row_count, token_count, block_count, output_stride, blocking, panel);
+		}
+
+		RT_TM_FORCE_INLINE static void gemm_q8_0_interleaved(const block_q8_0* weights, const block_q8_0* activations, float* output, uint64_t row_count,
+			uint64_t token_count, uint64_t block_count, uint64_t output_stride, const gemm_blocking& blocking) noexcept {
+			avx_2::gemm_q8_0_interleaved(weights, activations, output, row_count, token_count, block_count, output_stride, blocking);
+		}
+
+		RT_TM_FORCE_INLINE static void matvec_q8_0_interleaved(const block_q8_0* weights, const block_q8_0* activations, float* output, uint64_t row_count,
+			uint64_t block_count) noexcept {
+			avx_2::matvec_q8_0_interleaved(weights, activations, output, row_count, block_count);
+		}
+	};
+
+	template<> struct cpu_kernels<2> {
+		inline static constexpr uint64_t gemm_tile_rows{ avx_512::gemm_tile_rows };
+		inline static constexpr uint64_t gemm_tile_tokens{ avx_512::gemm_tile_tokens };
+
+		RT_TM_FORCE_INLINE static float vec_dot_q8_0_q8_0(const block_q8_0* weights, const block_q8_0* activations, uint64_t block_count) noexcept {
+			return avx_512::vec_dot_q8_0_q8_0(weights, activations, block_count);
+		}
+
+		RT_TM_FORCE_INLINE static void matvec_q8_0(const block_q8_0* weights, const block_q8_0* activations, float* output, uint64_t row_count, uint64_t block_count) noexcept {
+			avx_512::matvec_q8_0(weights, activations, output, row_count, block_count);
+		}
+
+		RT_TM_FORCE_INLINE static float vec_dot_q4_k_q8_k(const block_q4_k* weights, const block_q8_k* activations, uint64_t block_count) noexcept {
+			return avx_512::vec_dot_q4_k_q8_k(weights, activations, block_count);
+		}
+
+		RT_TM_FORCE_INLINE static float vec_dot_q5_k_q8_k(const block_q5_k* weights, const block_q8_k* activations, uint64_t block_count) noexcept {
+			return avx_512::vec_dot_q5_k_q8_k(weights, activations, block_count);
+		}
+
+		RT_TM_FORCE_INLINE static float vec_dot_q6_k_q8_k(const block_q6_k* weights, const block_q8_k* activations, uint64_t block_count) noexcept {
+			return avx_512::vec_dot_q6_k_q8_k(weights, activations, block_count);
+		}
+
+		RT_TM_FORCE_INLINE static void matvec_q4_k(const block_q4_k* weights, const block_q8_k* activations, float* output, uint64_t row_count, uint64_t block_count) noexcept {
+			avx_512::matvec_q4_k(weights, activations, output, row_count, block_count);
+		}
+
+		RT_TM_FORCE_INLINE static void matvec_q5_k(const block_q5_k* weights, const block_q8_k* activations, float* output, uint64_t row_count, uint64_t block_count) noexcept {
+			avx_512::matvec_q5_k(weights, activations, output, row_count, block_count);
+		}
+
+		RT_TM_FORCE_INLINE static void matvec_q6_k(const block_q6_k* weights, const block_q8_k* activations, float* output, uint64_t row_count, uint64_t block_count) noexcept {
+			avx_512::matvec_q6_k(weights, activations, output, row_count, block_count);
+		}
+
+		RT_TM_FORCE_INLINE static float vec_dot_iq4_nl_q8_0(const block_iq4_nl* weights, const block_q8_0* activations, uint64_t block_count) noexcept {
+			return avx_512::vec_dot_iq4_nl_q8_0(weights, activations, block_count);
+		}
+
+		RT_TM_FORCE_INLINE static float vec_dot_iq4_xs_q8_k(const block_iq4_xs* weights, const block_q8_k* activations, uint64_t block_count) noexcept {
+			return avx_512::vec_dot_iq4_xs_q8_k(weights, activations, block_count);
+		}
+
+		RT_TM_FORCE_INLINE static void matvec_iq4_nl(const block_iq4_nl* weights, const block_q8_0* activations, float* output, uint64_t row_count, uint64_t block_count) noexcept {
+			avx_512::matvec_iq4_nl(weights, activations, output, row_count, block_count);
+		}
+
+		RT_TM_FORCE_INLINE static void matvec_iq4_xs(const block_iq4_xs* weights, const block_q8_k* activations, float* output, uint64_t row_count, uint64_t block_count) noexcept {
+			avx_512::matvec_iq4_xs(weights, activations, output, row_count, block_count);
+		}
+
+		RT_TM_FORCE_INLINE static void gemm_q8_0(const block_q8_0* weights, const block_q8_0* activations, float* output, uint64_t row_count, uint64_t token_count,
+			uint64_t block_count, uint64_t output_stride, const gemm_blocking& blocking, block_q8_0* panel) noexcept {
+			avx_512::gemm_q8_0(weights, activations, output, row_count, token_count, block_count, output_stride, blocking, panel);
+		}
+
+		RT_TM_FORCE_INLINE static void gemm_q8_0_interleaved(const block_q8_0* weights, const block_q8_0* activations, float* output, uint64_t row_count,
+			uint64_t token_count, uint64_t block_count, uint64_t output_stride, const gemm_blocking& blocking) noexcept {
+			avx_512::gemm_q8_0_interleaved(weights, activations, output, row_count, token_count, block_count, output_stride, blocking);
+		}
+
+		RT_TM_FORCE_INLINE static void matvec_q8_0_interleaved(const block_q8_0* weights, const block_q8_0* activations, float* output, uint64_t row_count,
+			uint64_t block_count) noexcept {
+			avx_512::matvec_q8_0_interleaved(weights, activations, output, row_count, block_count);
+		}
+	};
+
+#endif
+
+	// output[token * output_stride + row] = W x for token_count activation rows of column_count floats each. The rows
+	// are quantized to q8_0 in the worker's scratch, as many at a time as fit; batches of at least min_gemm_tokens go
+	// through the blocked GEMM and shorter ones through one matvec per token. interleaved_rows is the
+	// model_core::interleaved_rows of the weights, which is either 1 or this tier's gemm_tile_rows. An output_stride of
+	// 0 means row_count; a larger one lets a worker compute a slice of rows of a wider output.
+	template<size_t cpu_index, global_config config> RT_TM_INLINE bool mul_mat_q8_0(const block_q8_0* weights, const float* input, float* output, uint64_t row_count,
+		uint64_t token_count, uint64_t column_count, cpu_op_context<config>& context, uint64_t min_gemm_tokens = gemm_min_tokens,
+		uint64_t interleaved_rows = 1, uint64_t output_stride = 0) noexcept(!config.exceptions) {
+		using kernels = cpu_kernels<cpu_index>;
+		output_stride = output_stride == 0 ? row_count : output_stride;
+		const bool interleaved{ interleaved_rows > 1 };
+		if (interleaved && interleaved_rows != kernels::gemm_tile_rows) {
+			if constexpr (config.exceptions) {
+				throw std::runtime_error{ "Sorry, but these weights were interleaved for a different CPU tier!" };
+			} else {
+				return false;
+			}
+		}
+		static const gemm_blocking cache_blocking{ get_gemm_blocking(cpu_arch_index_holder::cpu_cache_sizes, kernels::gemm_tile_rows, kernels::gemm_tile_tokens,
+			sizeof(block_q8_0)) };
+		const uint64_t block_count{ column_count / q8_0_block_size };
+		const uint64_t row_bytes{ block_count * sizeof(block_q8_0) };
+		gemm_blocking blocking{ cache_blocking };
+		bool use_gemm{ token_count >= min_gemm_tokens };
+		auto scratch_marker{ context.scratch.mark() };
+		block_q8_0* panel{};
+		if (use_gemm && !interleaved) {
+			// The panel shares the scratch with the quantized activations, so it gives up rows until a token tile, and up
+			// to half the scratch's worth of tokens, fits beside it. Without room for one row tile the matvecs run instead.
+			const uint64_t free_bytes{ context.scratch.size() - context.scratch.used() };
+			const uint64_t activation_tokens{ std::min({ token_count, blocking.token_block, std::max<uint64_t>(kernels::gemm_tile_tokens, free_bytes / 2 / row_bytes) }) };
+			const uint64_t activation_bytes{ activation_tokens * row_bytes + 128 };
+			const uint64_t panel_rows{ free_bytes > activation_bytes ? (free_bytes - activation_bytes) / (blocking.column_blocks * sizeof(block_q8_0)) : 0 };
+			blocking.row_block = std::min(blocking.row_block, panel_rows / kernels::gemm_tile_rows * kernels::gemm_tile_rows);
+			use_gemm		   = blocking.row_block > 0;
+			if (use_gemm) {
+				panel = reinterpret_cast<block_q8_0*>(context.scratch.claim_memory(blocking.row_block * blocking.column_blocks * sizeof(block_q8_0), 64));
+			}
+		}
+		const uint64_t free_bytes{ context.scratch.size() - context.scratch.used() };
+		const uint64_t token_block{ std::min({ token_count, use_gemm ? blocking.token_block : token_count, free_bytes > 64 ? (free_bytes - 64) / row_bytes : 0 }) };
+		if ((use_gemm && !interleaved && !panel) || token_block == 0) {
+			if constexpr (config.exceptions) {
+				throw std::runtime_error{ "Sorry, but the worker scratch is too small for this matrix multiplication!" };
+			} else {
+				return false;
+			}
+		}
+		for (uint64_t token = 0; token < token_count; token += token_block) {
+			auto block_marker{ context.scratch.mark() };
+			const uint64_t tokens{ std::min(token_block, token_count - token) };
+			block_q8_0* activations{ reinterpret_cast<block_q8_0*>(context.scratch.claim_memory(tokens * row_bytes, 64)) };
+			for (uint64_t x = 0; x < tokens; ++x) {
+				quantize_row_q8_0(input + (token + x) * column_count, activations + x * block_count, column_count);
+			}
+			if constexpr (kernels::gemm_tile_rows > 1) {
+				if (interleaved) {
+					if (use_gemm) {
+						kernels::gemm_q8_0_interleaved(weights, activations, output + token * output_stride, row_count, tokens, block_count, output_stride, blocking);
+					} else {
+						for (uint64_t x = 0; x < tokens; ++x) {
+							kernels::matvec_q8_0_interleaved(weights, activations + x * block_count, output + (token + x) * output_stride, row_count, block_count);
+						}
+					}
+					continue;
+				}
+			}
+			if (use_gemm) {
+				kernels::gemm_q8_0(weights, activations, output + token * output_stride, row_count, tokens, block_count, output_stride, blocking, panel);
+			} else {
+				for (uint64_t x = 0; x < tokens; ++x) {
+					kernels::matvec_q8_0(weights, activations + x * block_count, output + (token + x) * output_stride, row_count, block_count);
+				}
+			}
+		}
+		return true;
+	}
+
+}
@@ -22,4 +22,90 @@ AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABL
 FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT
 OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
 OR OTHER DEALINGS IN THE SOFTWARE.
-*/
\ No newline at end of file
+*/
+#pragma once
+
+#include <rt_tm/common/memory_buffer.hpp>
+#include <rt_tm/common/allocator.hpp>
+#include <rt_tm/common/numa.hpp>
+#include <rt_tm/common/common.hpp>
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace rt_tm {
+
+	// One private memory_buffer per worker for quantized activation rows and partial sums. Each region is padded to
+	// whole pages so no two workers share a cache line, and is allocated and first-touched by a thread of its own so
+	// its pages land on that thread's node.
+	template<global_config config> struct worker_scratch {
+		worker_scratch() noexcept = default;
+
+		RT_TM_INLINE worker_scratch(size_t thread_count, size_t bytes_per_thread) : arenas(std::max<size_t>(thread_count, 1)) {
+			const size_t padded_bytes{ roundUpToMultiple(std::max<size_t>(bytes_per_thread, 1), get_page_size()) };
+			if constexpr (config.numa) {
+				topology = numa_topology::detect();
+			}
+			std::vector<std::thread> threads{};
+			threads.reserve(arenas.size());
+			for (size_t x = 0; x < arenas.size(); ++x) {
+				threads.emplace_back([this, x, padded_bytes] {
+					if constexpr (config.numa) {
+						pin_worker(topology, x, arenas.size());
+					}
+					first_touch(x, padded_bytes);
+				});
+			}
+			for (auto& thread: threads) {
+				thread.join();
+			}
+		}
+
+		// Reallocates worker thread_index's arena from the calling thread, for pools that pin their workers later.
+		RT_TM_INLINE void first_touch(size_t thread_index, size_t padded_bytes) {
+			arenas[thread_index] = std::make_unique<memory_buffer<config, uint8_t>>(padded_bytes, std::source_location::current());
+			std::memset(arenas[thread_index]->data(), 0, arenas[thread_index]->size());
+		}
+
+		RT_TM_FORCE_INLINE memory_buffer<config, uint8_t>& operator[](size_t thread_index) noexcept {
+			return *arenas[thread_index];
+		}
+
+		RT_TM_FORCE_INLINE const memory_buffer<config, uint8_t>& operator[](size_t thread_index) const noexcept {
+			return *arenas[thread_index];
+		}
+
+		RT_TM_FORCE_INLINE size_t size() const noexcept {
+			return arenas.size();
+		}
+
+		RT_TM_FORCE_INLINE size_t get_node(size_t thread_index) const noexcept {
+			return topology.get_worker_node(thread_index, arenas.size());
+		}
+
+		RT_TM_FORCE_INLINE size_t get_node_count() const noexcept {
+			return std::max<size_t>(topology.size(), 1);
+		}
+
+		// The workers [first, second) that share node's row slices.
+		RT_TM_FORCE_INLINE std::pair<size_t, size_t> get_node_workers(size_t node) const noexcept {
+			return topology.get_node_workers(node, arenas.size());
+		}
+
+	  protected:
+		std::vector<std::unique_ptr<memory_buffer<config, uint8_t>>> arenas{};
+		numa_topology topology{};
+	};
+
+	// What a kernel sees while executing on one worker: its position in the pool, its NUMA node and its private scratch arena.
+	template<global_config config> struct cpu_op_context {
+		memory_buffer<config, uint8_t>& scratch;
+		size_t thread_index{};
+		size_t thread_count{};
+		size_t numa_node{};
+	};
+
+}
@@ -50,6 +50,13 @@ POSSIBILITY OF SUCH DAMAGE.
 #include <iostream>
 #include <array>
 #include <cstdlib>
+#include <fstream>
+#include <string>
+
+#if defined(__APPLE__)
+	#include <sys/sysctl.h>
+#endif
+
 #if defined(RT_TM_COMPILER_MSVC)
 	#include <intrin.h>
 #elif defined(HAVE_GCC_GET_CPUID) && defined(USE_GCC_GET_CPUID)
@@ -76,6 +83,8 @@ namespace rt_tm {
 		AVX512BW	= 0x2000,
 		AVX512VL	= 0x4000,
 		AVX512VBMI2 = 0x8000,
+		AVX512VNNI	= 0x10000,
+		AVX512VBMI	= 0x20000,
 	};
 
 #if defined(__aarch64__) || defined(_M_ARM64) || defined(_M_ARM64EC)
@@ -117,6 +126,8 @@ namespace rt_tm {
 		inline static constexpr uint64_t cpuid_avx512bw_bit	   = 1 << 30;
 		inline static constexpr uint64_t cpuid_avx512vl_bit	   = 1U << 31;
 		inline static constexpr uint64_t cpuid_avx512vbmi2_bit = 1 << 6;
+		inline static constexpr uint64_t cpuid_avx512vbmi_bit  = 1 << 1;
+		inline static constexpr uint64_t cpuid_avx512vnni_bit  = 1 << 11;
 		inline static constexpr uint64_t cpuid_avx256_saved	   = uint64_t(1) << 2;
 		inline static constexpr uint64_t cpuid_avx512_saved	   = uint64_t(7) << 5;
 		inline static constexpr uint64_t cpuid_sse42_bit	   = 1 << 20;
@@ -237,6 +248,14 @@ namespace rt_tm {
 			host_isa |= static_cast<uint64_t>(instruction_set::AVX512VBMI2);
 		}
 
+		if (ecx & cpuid_avx512vbmi_bit) {
+			host_isa |= static_cast<uint64_t>(instruction_set::AVX512VBMI);
+		}
+
+		if (ecx & cpuid_avx512vnni_bit) {
+			host_isa |= static_cast<uint64_t>(instruction_set::AVX512VNNI);
+		}
+
 		return static_cast<instruction_set>(host_isa);
 	}
 
@@ -268,9 +287,60 @@ namespace rt_tm {
 #endif
 	}
 
+	// Per-core data cache sizes in bytes, used to size the GEMM blocking. Falls back to common desktop values when the
+	// platform does not report them.
+	struct cache_sizes {
+		uint64_t l1_data{ 32 * 1024 };
+		uint64_t l2{ 1024 * 1024 };
+		uint64_t l3{ 8 * 1024 * 1024 };
+	};
+
+	inline cache_sizes get_cache_sizes() {
+		cache_sizes sizes{};
+#if defined(__linux__)
+		for (uint64_t index = 0; index < 8; ++index) {
+			const std::string path{ "/sys/devices/system/cpu/cpu0/cache/index" + std::to_string(index) + "/" };
+			std::ifstream level_file{ path + "level" }, type_file{ path + "type" }, size_file{ path + "size" };
+			uint64_t level{}, size{};
+			std::string type{}, unit{};
+			if (!(level_file >> level) || !(type_file >> type) || !(size_file >> size)) {
+				break;
+			}
+			size_file >> unit;
+			size *= unit == "K" ? 1024 : unit == "M" ? 1024 * 1024 : 1;
+			if (type == "Instruction" || size == 0) {
+				continue;
+			}
+			if (level == 1) {
+				sizes.l1_data = size;
+			} else if (level == 2) {
+				sizes.l2 = size;
+			} else if (level == 3) {
+				sizes.l3 = size;
+			}
+		}
+#elif defined(__APPLE__)
+		const auto read_size = [](const char* name, uint64_t& value) {
+			uint64_t result{};
+			size_t size{ sizeof(result) };
+			if (sysctlbyname(name, &result, &size, nullptr, 0) == 0 && result != 0) {
+				value = result;
+			}
+		};
+		read_size("hw.l1dcachesize", sizes.l1_data);
+		read_size("hw.l2cachesize", sizes.l2);
+		read_size("hw.l3cachesize", sizes.l3);
+#endif
+		return sizes;
+	}
+
 	struct cpu_arch_index_holder {
 		inline static const instruction_set cpu_arch{ get_detect_supported_architectures() };
 		inline static const auto cpu_arch_index{ get_cpu_arch_index(cpu_arch) };
+		// RT_TM_DISABLE_AVX512_VNNI forces the AVX-512 kernels onto their maddubs path, so it can be tested on VNNI hardware.
+		inline static const bool has_avx512_vnni{ (static_cast<uint64_t>(cpu_arch) & static_cast<uint64_t>(instruction_set::AVX512VNNI)) != 0 &&
+			!std::getenv("RT_TM_DISABLE_AVX512_VNNI") };
+		inline static const cache_sizes cpu_cache_sizes{ get_cache_sizes() };
 	};
 
 	static constexpr array<size_t, 4> alignments{ 8, 32, 64 };
@@ -24,10 +24,14 @@ OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
 OR OTHER DEALINGS IN THE SOFTWARE.
 */
 #include <rt_tm/cpu/detect_isa.hpp>
+#include <rt_tm/cpu/cpu_kernels.hpp>
 #include <rt_tm/common/model_parser.hpp>
 #include <rt_tm/common/model_graph.hpp>
+#include <rt_tm/common/weight_cache.hpp>
 #include <rt_tm/common/debugging_io.hpp>
 #include <rt_tm/common/memory_buffer.hpp>
+#include <rt_tm/common/input_session.hpp>
+#include <rt_tm/common/prefix_cache.hpp>
 #include <rt_tm/common/array.hpp>
 #include <rt_tm/common/core.hpp>
 #include <rt_tm/op_graph.hpp>
\ No newline at end of file
@@ -25,12 +25,24 @@ OR OTHER DEALINGS IN THE SOFTWARE.
 */
 #pragma once
 
+#include <rt_tm/common/activation_planner.hpp>
+#include <rt_tm/cpu/cpu_op_core.hpp>
+#include <rt_tm/cpu/cpu_kernels.hpp>
+#include <rt_tm/common/model_core.hpp>
+#include <rt_tm/common/model_graph.hpp>
+#include <rt_tm/common/kv_cache.hpp>
+#include <rt_tm/common/telemetry.hpp>
 #include <rt_tm/common/common.hpp>
+#include <memory>
+#include <utility>
 
 namespace rt_tm {
 
 	struct op_graph_config {
 		size_t num_threads{};
+		size_t scratch_bytes_per_thread{ 1024 * 1024 };
+		data_type kv_type{ data_type::float_32 };
+		uint64_t gemm_token_threshold{ gemm_min_tokens };
 	};
 
 	struct impl_indices {
@@ -39,6 +51,14 @@ namespace rt_tm {
 	};
 
 	struct op_graph_base_low {
+		op_graph_config config_val{};
+
+		RT_TM_FORCE_INLINE op_graph_base_low(op_graph_config graph_config = {}) : config_val{ graph_config } {};
+
+		RT_TM_INLINE kv_cache_config get_kv_cache_config(const hyper_parameters& hparams, uint64_t max_tokens, uint64_t block_tokens = 16) const {
+			return kv_cache_config::from_hparams(hparams, max_tokens, block_tokens, config_val.kv_type);
+		}
+
 		virtual ~op_graph_base_low() {
 		}
 	};
@@ -46,9 +66,71 @@ namespace rt_tm {
 	template<global_config config, impl_indices indices_new> struct op_graph_base : public op_graph_base_low {
 	  public:
 		inline static constexpr impl_indices indices{ indices_new };
-		op_graph_config config_val{};
+		std::unique_ptr<activation_arena<config>> activations{};
+		worker_scratch<config> scratch{};
+
+		RT_TM_FORCE_INLINE op_graph_base(op_graph_config graph_config)
+			: op_graph_base_low{ graph_config }, scratch{ graph_config.num_threads, graph_config.scratch_bytes_per_thread } {};
+
+		// Per-thread scratch capacity and high-water marks plus the activation arena's planned size; process-wide
+		// counters live in memory_accounting::get().snapshot().
+		RT_TM_INLINE graph_memory_report get_memory_report() const {
+			graph_memory_report return_value{};
+			for (size_t x = 0; x < scratch.size(); ++x) {
+				return_value.scratch.emplace_back(scratch_memory{ scratch[x].size(), scratch[x].high_water() });
+			}
+			if (activations) {
+				return_value.activation_planned_bytes = activations->peak_bytes;
+				return_value.activation_naive_bytes	  = activations->naive_bytes;
+			}
+			return return_value;
+		}
+
+		RT_TM_FORCE_INLINE cpu_op_context<config> get_context(size_t thread_index) noexcept {
+			return { scratch[thread_index], thread_index, scratch.size(), scratch.get_node(thread_index) };
+		}
+
+		// Projects token_count activation rows through q8_0 weight matrix tensor_index of graph on worker thread_index,
+		// switching from per-token matvecs to the blocked GEMM at config_val.gemm_token_threshold tokens. Every worker
+		// must call it: each one computes its share of the rows. When graph.place_numa split the tensor, a worker only
+		// takes rows from its own node's slice, and replicated tensors are read from the node's copy. Weights repacked by
+		// a weight_cache go through the interleaved kernels, with shares rounded to whole tiles.
+		RT_TM_INLINE bool mul_mat_q8_0(size_t thread_index, const model_graph& graph, size_t tensor_index, const float* input, float* output,
+			uint64_t token_count) noexcept(!config.exceptions) {
+			cpu_op_context<config> context{ get_context(thread_index) };
+			const model_core& weights{ graph.model_cores[tensor_index] };
+			const uint64_t row_count{ weights.dimensions[1] };
+			const uint64_t block_count{ weights.dimensions[0] / q8_0_block_size };
+			const uint64_t tile_rows{ std::max<uint64_t>(weights.interleaved_rows, 1) };
+			const size_t node_count{ scratch.get_node_count() };
+			uint64_t first_row{};
+			uint64_t last_row{ row_count };
+			std::pair<size_t, size_t> workers{ 0, scratch.size() };
+			if (tensor_index < graph.numa_placements.size() && graph.numa_placements[tensor_index].row_splits.size() == node_count + 1) {
+				const std::vector<uint64_t>& row_splits{ graph.numa_placements[tensor_index].row_splits };
+				first_row = std::min(row_splits[context.numa_node], row_count);
+				last_row  = context.numa_node + 1 == node_count ? row_count : std::min(row_splits[context.numa_node + 1], row_count);
+				workers	  = scratch.get_node_workers(context.numa_node);
+			}
+			const uint64_t worker_count{ std::max<uint64_t>(workers.second - workers.first, 1) };
+			const uint64_t share{ roundUpToMultiple((last_row - first_row + worker_count - 1) / worker_count, tile_rows) };
+			const uint64_t begin{ std::min(first_row + (thread_index - workers.first) * share, last_row) };
+			const uint64_t end{ std::min(begin + share, last_row) };
+			if (begin == end) {
+				return true;
+			}
+			const block_q8_0* data{ static_cast<const block_q8_0*>(graph.get_node_data(tensor_index, context.numa_node)) };
+			return rt_tm::mul_mat_q8_0<indices.cpu_index>(data + begin * block_count, input, output + begin, end - begin, token_count, weights.dimensions[0], context,
+				config_val.gemm_token_threshold, weights.interleaved_rows, row_count);
+		}
 
-		RT_TM_FORCE_INLINE op_graph_base(op_graph_config graph_config) : config_val{ graph_config } {};
+		// Backs every intermediate with one arena laid out from the tensors' lifetimes; returns the plan so callers
+		// can compare its peak against the naive total.
+		RT_TM_INLINE activation_plan plan_activations(const std::vector<tensor_lifetime>& lifetimes) {
+			activation_plan return_value{ activation_planner::plan(lifetimes) };
+			activations = std::make_unique<activation_arena<config>>(return_value);
+			return return_value;
+		}
 
 		RT_TM_FORCE_INLINE ~op_graph_base() {
 		}
@@ -108,6 +190,14 @@ namespace rt_tm {
 			}();
 		}
 
+		RT_TM_FORCE_INLINE const op_graph_config& get_config() const noexcept {
+			return op_graph_val->config_val;
+		}
+
+		RT_TM_INLINE kv_cache_config get_kv_cache_config(const hyper_parameters& hparams, uint64_t max_tokens, uint64_t block_tokens = 16) const {
+			return op_graph_val->get_kv_cache_config(hparams, max_tokens, block_tokens);
+		}
+
 	  protected:
 		std::unique_ptr<op_graph_base_low> op_graph_val{};
 	};
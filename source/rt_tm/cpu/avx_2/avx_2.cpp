@@ -0,0 +1,331 @@
+/*
+MIT License
+
+Copyright (c) 2025 RealTimeChris (Chris M)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "RT-TM Library"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+This file was independently created by RealTimeChris (Chris M), without reuse
+or derivation from any codebase owned by other entities, including any contract work.
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT
+OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <rt_tm/cpu/avx_2/avx_2.hpp>
+#include <immintrin.h>
+#include <algorithm>
+
+namespace rt_tm::avx_2 {
+
+	namespace {
+
+		RT_TM_FORCE_INLINE __m256i load_quants(const int8_t* quants) noexcept {
+			return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(quants));
+		}
+
+		RT_TM_FORCE_INLINE float horizontal_sum(__m256 values) noexcept {
+			__m128 sum{ _mm_add_ps(_mm256_castps256_ps128(values), _mm256_extractf128_ps(values, 1)) };
+			sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+			sum = _mm_add_ss(sum, _mm_movehdup_ps(sum));
+			return _mm_cvtss_f32(sum);
+		}
+
+		// maddubs wants an unsigned left operand, so the weight signs are moved onto the activations first.
+		// Quantization keeps both sides within [-127, 127], which keeps the pairwise int16 sums from saturating.
+		RT_TM_FORCE_INLINE __m256 dot_block(const block_q8_0& weights, const block_q8_0& activations) noexcept {
+			const __m256i weight_quants{ load_quants(weights.quants) };
+			const __m256i activation_quants{ load_quants(activations.quants) };
+			const __m256i products{ _mm256_maddubs_epi16(_mm256_sign_epi8(weight_quants, weight_quants), _mm256_sign_epi8(activation_quants, weight_quants)) };
+			return _mm256_cvtepi32_ps(_mm256_madd_epi16(products, _mm256_set1_epi16(1)));
+		}
+
+		RT_TM_FORCE_INLINE __m256 get_scale(const block_q8_0& weights, const block_q8_0& activations) noexcept {
+			return _mm256_set1_ps(fp16_to_fp32(weights.scale) * fp16_to_fp32(activations.scale));
+		}
+
+		RT_TM_FORCE_INLINE __m256i load_bytes(const uint8_t* bytes) noexcept {
+			return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bytes));
+		}
+
+		// Unsigned 32-element sub-block against its q8_k slice, weighted by the sub-block scale(s): one int16 scale per
+		// 128-bit lane, so q6_k can pass its two 16-element scales and q4_k/q5_k a single one twice.
+		RT_TM_FORCE_INLINE __m256i dot_sub_block(__m256i quants, const int8_t* activation_quants, int32_t scale_01, int32_t scale_02) noexcept {
+			const __m256i scales{ _mm256_set_m128i(_mm_set1_epi16(static_cast<int16_t>(scale_02)), _mm_set1_epi16(static_cast<int16_t>(scale_01))) };
+			return _mm256_madd_epi16(_mm256_maddubs_epi16(quants, load_quants(activation_quants)), scales);
+		}
+
+		// The fifth bit of q5_k sub-block n is bit n of each high_bits byte.
+		RT_TM_FORCE_INLINE __m256i get_q5_k_high_bits(__m256i high_bits, int32_t sub) noexcept {
+			return _mm256_slli_epi16(_mm256_and_si256(_mm256_srl_epi16(high_bits, _mm_cvtsi32_si128(sub)), _mm256_set1_epi8(1)), 4);
+		}
+
+		template<bool has_high_bits, typename block_type>
+		RT_TM_FORCE_INLINE float vec_dot_q4_5_k_q8_k(const block_type* weights, const block_q8_k* activations, uint64_t block_count) noexcept {
+			const __m256i low_mask{ _mm256_set1_epi8(0x0F) };
+			__m256 accumulator{ _mm256_setzero_ps() };
+			float min_accumulator{};
+			for (uint64_t block = 0; block < block_count; ++block) {
+				uint8_t scales[16];
+				unpack_k_scales(weights[block].scales, scales);
+				__m256i high_bits{};
+				if constexpr (has_high_bits) {
+					high_bits = load_bytes(weights[block].high_bits);
+				}
+				__m256i sum{ _mm256_setzero_si256() };
+				for (int32_t chunk = 0; chunk < 4; ++chunk) {
+					const __m256i bits{ load_bytes(weights[block].quants + chunk * 32) };
+					__m256i low{ _mm256_and_si256(bits, low_mask) };
+					__m256i high{ _mm256_and_si256(_mm256_srli_epi16(bits, 4), low_mask) };
+					if constexpr (has_high_bits) {
+						low	 = _mm256_or_si256(low, get_q5_k_high_bits(high_bits, chunk * 2));
+						high = _mm256_or_si256(high, get_q5_k_high_bits(high_bits, chunk * 2 + 1));
+					}
+					sum = _mm256_add_epi32(sum, dot_sub_block(low, activations[block].quants + chunk * 64, scales[chunk * 2], scales[chunk * 2]));
+					sum = _mm256_add_epi32(sum, dot_sub_block(high, activations[block].quants + chunk * 64 + 32, scales[chunk * 2 + 1], scales[chunk * 2 + 1]));
+				}
+				accumulator = _mm256_fmadd_ps(_mm256_set1_ps(activations[block].scale * fp16_to_fp32(weights[block].scale)), _mm256_cvtepi32_ps(sum), accumulator);
+				min_accumulator += activations[block].scale * fp16_to_fp32(weights[block].min_scale) *
+					static_cast<float>(get_k_min_sum(scales + 8, activations[block].block_sums));
+			}
+			return horizontal_sum(accumulator) - min_accumulator;
+		}
+
+		// q6_k quants are dotted unsigned (0..63); the implicit -32 is applied afterwards through the block sums.
+		RT_TM_FORCE_INLINE __m256i get_q6_k_group(__m256i low_bits, __m256i high_bits, int32_t low_shift, int32_t high_shift) noexcept {
+			const __m256i low{ _mm256_and_si256(_mm256_srl_epi16(low_bits, _mm_cvtsi32_si128(low_shift)), _mm256_set1_epi8(0x0F)) };
+			const __m256i high{ _mm256_and_si256(_mm256_srl_epi16(high_bits, _mm_cvtsi32_si128(high_shift)), _mm256_set1_epi8(3)) };
+			return _mm256_or_si256(low, _mm256_slli_epi16(high, 4));
+		}
+
+
+		// One tile_rows x tile_tokens register tile over a packed panel; activations points at the tile's first token,
+		// already offset to the panel's first column block.
+		template<uint64_t tile_tokens> RT_TM_FORCE_INLINE void gemm_q8_0_tile(const block_q8_0* panel, const block_q8_0* activations, uint64_t block_count,
+			uint64_t column_count, float* output, uint64_t output_stride, uint64_t valid_rows) noexcept {
+			const __m256i ones{ _mm256_set1_epi16(1) };
+			__m256 accumulators[gemm_tile_rows][tile_tokens];
+			for (uint64_t row = 0; row < gemm_tile_rows; ++row) {
+				for (uint64_t token = 0; token < tile_tokens; ++token) {
+					accumulators[row][token] = _mm256_setzero_ps();
+				}
+			}
+			for (uint64_t column = 0; column < column_count; ++column) {
+				__m256i activation_quants[tile_tokens];
+				float activation_scales[tile_tokens];
+				for (uint64_t token = 0; token < tile_tokens; ++token) {
+					activation_quants[token] = load_quants(activations[token * block_count + column].quants);
+					activation_scales[token] = fp16_to_fp32(activations[token * block_count + column].scale);
+				}
+				const block_q8_0* column_blocks{ panel + column * gemm_tile_rows };
+				for (uint64_t row = 0; row < gemm_tile_rows; ++row) {
+					const __m256i weight_quants{ load_quants(column_blocks[row].quants) };
+					const __m256i magnitudes{ _mm256_sign_epi8(weight_quants, weight_quants) };
+					const float weight_scale{ fp16_to_fp32(column_blocks[row].scale) };
+					for (uint64_t token = 0; token < tile_tokens; ++token) {
+						const __m256i products{ _mm256_maddubs_epi16(magnitudes, _mm256_sign_epi8(activation_quants[token], weight_quants)) };
+						accumulators[row][token] = _mm256_fmadd_ps(_mm256_set1_ps(weight_scale * activation_scales[token]), _mm256_cvtepi32_ps(_mm256_madd_epi16(products, ones)),
+							accumulators[row][token]);
+					}
+				}
+			}
+			for (uint64_t token = 0; token < tile_tokens; ++token) {
+				for (uint64_t row = 0; row < valid_rows; ++row) {
+					output[token * output_stride + row] += horizontal_sum(accumulators[row][token]);
+				}
+			}
+		}
+
+		// With interleaved weights each tile's column blocks are already contiguous in the tensor, so the panel is
+		// read in place instead of being packed.
+		template<bool interleaved> RT_TM_FORCE_INLINE void gemm_q8_0_impl(const block_q8_0* weights, const block_q8_0* activations, float* output, uint64_t row_count,
+			uint64_t token_count, uint64_t block_count, uint64_t output_stride, const gemm_blocking& blocking, block_q8_0* panel) noexcept {
+			for (uint64_t token = 0; token < token_count; ++token) {
+				std::fill_n(output + token * output_stride, row_count, 0.0f);
+			}
+			for (uint64_t column_block = 0; column_block < block_count; column_block += blocking.column_blocks) {
+				const uint64_t column_count{ std::min(blocking.column_blocks, block_count - column_block) };
+				for (uint64_t row_block = 0; row_block < row_count; row_block += blocking.row_block) {
+					const uint64_t rows{ std::min(blocking.row_block, row_count - row_block) };
+					if constexpr (!interleaved) {
+						pack_weight_panel(weights + row_block * block_count, rows, block_count, column_block, column_count, gemm_tile_rows, panel);
+					}
+					const auto get_tile = [&](uint64_t row) {
+						if constexpr (interleaved) {
+							return weights + (row_block + row) * block_count + column_block * gemm_tile_rows;
+						} else {
+							return static_cast<const block_q8_0*>(panel + row * column_count);
+						}
+					};
+					uint64_t token{};
+					for (; token + gemm_tile_tokens <= token_count; token += gemm_tile_tokens) {
+						for (uint64_t row = 0; row < rows; row += gemm_tile_rows) {
+							gemm_q8_0_tile<gemm_tile_tokens>(get_tile(row), activations + token * block_count + column_block, block_count, column_count,
+								output + token * output_stride + row_block + row, output_stride, std::min(gemm_tile_rows, rows - row));
+						}
+					}
+					for (; token < token_count; ++token) {
+						for (uint64_t row = 0; row < rows; row += gemm_tile_rows) {
+							gemm_q8_0_tile<1>(get_tile(row), activations + token * block_count + column_block, block_count, column_count,
+								output + token * output_stride + row_block + row, output_stride, std::min(gemm_tile_rows, rows - row));
+						}
+					}
+				}
+			}
+		}
+
+		// Looks 32 nibbles up in the iq4 codebook with pshufb: the low nibbles of bits give elements 0..15 and the high
+		// nibbles 16..31.
+		RT_TM_FORCE_INLINE __m256i get_iq4_values(const uint8_t* quants, __m256i codebook) noexcept {
+			const __m128i bits{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(quants)) };
+			const __m128i low_mask{ _mm_set1_epi8(0x0F) };
+			const __m256i indices{ _mm256_set_m128i(_mm_and_si128(_mm_srli_epi16(bits, 4), low_mask), _mm_and_si128(bits, low_mask)) };
+			return _mm256_shuffle_epi8(codebook, indices);
+		}
+
+		RT_TM_FORCE_INLINE __m256i load_iq4_codebook() noexcept {
+			return _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(iq4_values)));
+		}
+
+		RT_TM_FORCE_INLINE __m256i dot_signed_pairs(__m256i values, __m256i activation_quants) noexcept {
+			return _mm256_maddubs_epi16(_mm256_sign_epi8(values, values), _mm256_sign_epi8(activation_quants, values));
+		}
+	}
+
+	float vec_dot_q8_0_q8_0(const block_q8_0* weights, const block_q8_0* activations, uint64_t block_count) noexcept {
+		__m256 accumulator_01{ _mm256_setzero_ps() };
+		__m256 accumulator_02{ _mm256_setzero_ps() };
+		uint64_t block{};
+		for (; block + 2 <= block_count; block += 2) {
+			accumulator_01 = _mm256_fmadd_ps(get_scale(weights[block], activations[block]), dot_block(weights[block], activations[block]), accumulator_01);
+			accumulator_02 = _mm256_fmadd_ps(get_scale(weights[block + 1], activations[block + 1]), dot_block(weights[block + 1], activations[block + 1]), accumulator_02);
+		}
+		if (block < block_count) {
+			accumulator_01 = _mm256_fmadd_ps(get_scale(weights[block], activations[block]), dot_block(weights[block], activations[block]), accumulator_01);
+		}
+		return horizontal_sum(_mm256_add_ps(accumulator_01, accumulator_02));
+	}
+
+	void matvec_q8_0(const block_q8_0* weights, const block_q8_0* activations, float* output, uint64_t row_count, uint64_t block_count) noexcept {
+		for (uint64_t row = 0; row < row_count; ++row) {
+			output[row] = avx_2::vec_dot_q8_0_q8_0(weights + row * block_count, activations, block_count);
+		}
+	}
+
+	float vec_dot_q4_k_q8_k(const block_q4_k* weights, const block_q8_k* activations, uint64_t block_count) noexcept {
+		return vec_dot_q4_5_k_q8_k<false>(weights, activations, block_count);
+	}
+
+	float vec_dot_q5_k_q8_k(const block_q5_k* weights, const block_q8_k* activations, uint64_t block_count) noexcept {
+		return vec_dot_q4_5_k_q8_k<true>(weights, activations, block_count);
+	}
+
+	float vec_dot_q6_k_q8_k(const block_q6_k* weights, const block_q8_k* activations, uint64_t block_count) noexcept {
+		__m256 accumulator{ _mm256_setzero_ps() };
+		float offset_accumulator{};
+		for (uint64_t block = 0; block < block_count; ++block) {
+			const int8_t* scales{ weights[block].scales };
+			__m256i sum{ _mm256_setzero_si256() };
+			for (uint64_t half = 0; half < 2; ++half) {
+				const __m256i low_bits_01{ load_bytes(weights[block].low_bits + half * 64) };
+				const __m256i low_bits_02{ load_bytes(weights[block].low_bits + half * 64 + 32) };
+				const __m256i high_bits{ load_bytes(weights[block].high_bits + half * 32) };
+				const int8_t* activation_quants{ activations[block].quants + half * 128 };
+				const int8_t* half_scales{ scales + half * 8 };
+				sum = _mm256_add_epi32(sum, dot_sub_block(get_q6_k_group(low_bits_01, high_bits, 0, 0), activation_quants, half_scales[0], half_scales[1]));
+				sum = _mm256_add_epi32(sum, dot_sub_block(get_q6_k_group(low_bits_02, high_bits, 0, 2), activation_quants + 32, half_scales[2], half_scales[3]));
+				sum = _mm256_add_epi32(sum, dot_sub_block(get_q6_k_group(low_bits_01, high_bits, 4, 4), activation_quants + 64, half_scales[4], half_scales[5]));
+				sum = _mm256_add_epi32(sum, dot_sub_block(get_q6_k_group(low_bits_02, high_bits, 4, 6), activation_quants + 96, half_scales[6], half_scales[7]));
+			}
+			const float scale{ activations[block].scale * fp16_to_fp32(weights[block].scale) };
+			accumulator = _mm256_fmadd_ps(_mm256_set1_ps(scale), _mm256_cvtepi32_ps(sum), accumulator);
+			offset_accumulator += scale * static_cast<float>(get_q6_k_offset_sum(scales, activations[block].block_sums));
+		}
+		return horizontal_sum(accumulator) - offset_accumulator;
+	}
+
+	void matvec_q4_k(const block_q4_k* weights, const block_q8_k* activations, float* output, uint64_t row_count, uint64_t block_count) noexcept {
+		for (uint64_t row = 0; row < row_count; ++row) {
+			output[row] = vec_dot_q4_5_k_q8_k<false>(weights + row * block_count, activations, block_count);
+		}
+	}
+
+	void matvec_q5_k(const block_q5_k* weights, const block_q8_k* activations, float* output, uint64_t row_count, uint64_t block_count) noexcept {
+		for (uint64_t row = 0; row < row_count; ++row) {
+			output[row] = vec_dot_q4_5_k_q8_k<true>(weights + row * block_count, activations, block_count);
+		}
+	}
+
+	void matvec_q6_k(const block_q6_k* weights, const block_q8_k* activations, float* output, uint64_t row_count, uint64_t block_count) noexcept {
+		for (uint64_t row = 0; row < row_count; ++row) {
+			output[row] = avx_2::vec_dot_q6_k_q8_k(weights + row * block_count, activations, block_count);
+		}
+	}
+
+	void gemm_q8_0(const block_q8_0* weights, const block_q8_0* activations, float* output, uint64_t row_count, uint64_t token_count, uint64_t block_count,
+		uint64_t output_stride, const gemm_blocking& blocking, block_q8_0* panel) noexcept {
+		gemm_q8_0_impl<false>(weights, activations, output, row_count, token_count, block_count, output_stride, blocking, panel);
+	}
+
+	void gemm_q8_0_interleaved(const block_q8_0* weights, const block_q8_0* activations, float* output, uint64_t row_count, uint64_t token_count,
+		uint64_t block_count, uint64_t output_stride, const gemm_blocking& blocking) noexcept {
+		gemm_q8_0_impl<true>(weights, activations, output, row_count, token_count, block_count, output_stride, blocking, nullptr);
+	}
+
+	void matvec_q8_0_interleaved(const block_q8_0* weights, const block_q8_0* activations, float* output, uint64_t row_count, uint64_t block_count) noexcept {
+		std::fill_n(output, row_count, 0.0f);
+		for (uint64_t row = 0; row < row_count; row += gemm_tile_rows) {
+			gemm_q8_0_tile<1>(weights + row * block_count, activations, block_count, block_count, output + row, 0, std::min(gemm_tile_rows, row_count - row));
+		}
+	}
+
+	float vec_dot_iq4_nl_q8_0(const block_iq4_nl* weights, const block_q8_0* activations, uint64_t block_count) noexcept {
+		const __m256i codebook{ load_iq4_codebook() };
+		const __m256i ones{ _mm256_set1_epi16(1) };
+		__m256 accumulator{ _mm256_setzero_ps() };
+		for (uint64_t block = 0; block < block_count; ++block) {
+			const __m256i products{ dot_signed_pairs(get_iq4_values(weights[block].quants, codebook), load_quants(activations[block].quants)) };
+			const float scale{ fp16_to_fp32(weights[block].scale) * fp16_to_fp32(activations[block].scale) };
+			accumulator = _mm256_fmadd_ps(_mm256_set1_ps(scale), _mm256_cvtepi32_ps(_mm256_madd_epi16(products, ones)), accumulator);
+		}
+		return horizontal_sum(accumulator);
+	}
+
+	float vec_dot_iq4_xs_q8_k(const block_iq4_xs* weights, const block_q8_k* activations, uint64_t block_count) noexcept {
+		const __m256i codebook{ load_iq4_codebook() };
+		__m256 accumulator{ _mm256_setzero_ps() };
+		for (uint64_t block = 0; block < block_count; ++block) {
+			__m256i sum{ _mm256_setzero_si256() };
+			for (uint64_t sub = 0; sub < 8; ++sub) {
+				const __m256i products{ dot_signed_pairs(get_iq4_values(weights[block].quants + sub * 16, codebook), load_quants(activations[block].quants + sub * 32)) };
+				sum = _mm256_add_epi32(sum, _mm256_madd_epi16(products, _mm256_set1_epi16(static_cast<int16_t>(get_iq4_xs_scale(weights[block], sub)))));
+			}
+			accumulator = _mm256_fmadd_ps(_mm256_set1_ps(fp16_to_fp32(weights[block].scale) * activations[block].scale), _mm256_cvtepi32_ps(sum), accumulator);
+		}
+		return horizontal_sum(accumulator);
+	}
+
+	void matvec_iq4_nl(const block_iq4_nl* weights, const block_q8_0* activations, float* output, uint64_t row_count, uint64_t block_count) noexcept {
+		for (uint64_t row = 0; row < row_count; ++row) {
+			output[row] = avx_2::vec_dot_iq4_nl_q8_0(weights + row * block_count, activations, block_count);
+		}
+	}
+
+	void matvec_iq4_xs(const block_iq4_xs* weights, const block_q8_k* activations, float* output, uint64_t row_count, uint64_t block_count) noexcept {
+		for (uint64_t row = 0; row < row_count; ++row) {
+			output[row] = avx_2::vec_dot_iq4_xs_q8_k(weights + row * block_count, activations, block_count);
+		}
+	}
+
+}
@@ -0,0 +1,415 @@
+/*
+MIT License
+
+Copyright (c) 2025 RealTimeChris (Chris M)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "RT-TM Library"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+This file was independently created by RealTimeChris (Chris M), without reuse
+or derivation from any codebase owned by other entities, including any contract work.
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT
+OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <rt_tm/cpu/avx_512/avx_512.hpp>
+#include <rt_tm/cpu/detect_isa.hpp>
+#include <immintrin.h>
+#include <algorithm>
+
+namespace rt_tm::avx_512 {
+
+	namespace {
+
+		// Two q8_0 blocks per register; a missing second block is zero-filled.
+		RT_TM_FORCE_INLINE __m512i load_quants(const block_q8_0& first, const block_q8_0& second, bool pair) noexcept {
+			const __m512i low{ _mm512_maskz_loadu_epi64(0x0F, first.quants) };
+			return pair ? _mm512_inserti64x4(low, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(second.quants)), 1) : low;
+		}
+
+		RT_TM_FORCE_INLINE __m512i load_quants(const block_q8_0* blocks, bool pair) noexcept {
+			return load_quants(blocks[0], blocks[1], pair);
+		}
+
+		RT_TM_FORCE_INLINE __m512 load_scales(const block_q8_0& first, const block_q8_0& second, bool pair) noexcept {
+			return _mm512_mask_blend_ps(0xFF00, _mm512_set1_ps(fp16_to_fp32(first.scale)), _mm512_set1_ps(pair ? fp16_to_fp32(second.scale) : 0.0f));
+		}
+
+		template<typename block_type> RT_TM_FORCE_INLINE __m512 get_scales(const block_type* weights, const block_q8_0* activations, bool pair) noexcept {
+			const float scale_01{ fp16_to_fp32(weights[0].scale) * fp16_to_fp32(activations[0].scale) };
+			const float scale_02{ pair ? fp16_to_fp32(weights[1].scale) * fp16_to_fp32(activations[1].scale) : 0.0f };
+			return _mm512_mask_blend_ps(0xFF00, _mm512_set1_ps(scale_01), _mm512_set1_ps(scale_02));
+		}
+
+		// Both vpdpbusd and maddubs take an unsigned left operand, so the weight signs are moved onto the activations.
+		template<bool vnni> RT_TM_FORCE_INLINE __m512 dot_signed(__m512i magnitudes, __mmask64 negative, __m512i activation_quants) noexcept {
+			const __m512i signed_activations{ _mm512_mask_sub_epi8(activation_quants, negative, _mm512_setzero_si512(), activation_quants) };
+			if constexpr (vnni) {
+				return _mm512_cvtepi32_ps(_mm512_dpbusd_epi32(_mm512_setzero_si512(), magnitudes, signed_activations));
+			} else {
+				return _mm512_cvtepi32_ps(_mm512_madd_epi16(_mm512_maddubs_epi16(magnitudes, signed_activations), _mm512_set1_epi16(1)));
+			}
+		}
+
+		template<bool vnni> RT_TM_FORCE_INLINE __m512 dot_block_pair(__m512i weight_quants, __m512i activation_quants) noexcept {
+			return dot_signed<vnni>(_mm512_abs_epi8(weight_quants), _mm512_movepi8_mask(weight_quants), activation_quants);
+		}
+
+		template<bool vnni> RT_TM_FORCE_INLINE float vec_dot_q8_0_q8_0_impl(const block_q8_0* weights, const block_q8_0* activations, uint64_t block_count) noexcept {
+			__m512 accumulator_01{ _mm512_setzero_ps() };
+			__m512 accumulator_02{ _mm512_setzero_ps() };
+			uint64_t block{};
+			for (; block + 4 <= block_count; block += 4) {
+				accumulator_01 = _mm512_fmadd_ps(get_scales(weights + block, activations + block, true),
+					dot_block_pair<vnni>(load_quants(weights + block, true), load_quants(activations + block, true)), accumulator_01);
+				accumulator_02 = _mm512_fmadd_ps(get_scales(weights + block + 2, activations + block + 2, true),
+					dot_block_pair<vnni>(load_quants(weights + block + 2, true), load_quants(activations + block + 2, true)), accumulator_02);
+			}
+			for (; block < block_count; block += 2) {
+				const bool pair{ block + 2 <= block_count };
+				accumulator_01 = _mm512_fmadd_ps(get_scales(weights + block, activations + block, pair),
+					dot_block_pair<vnni>(load_quants(weights + block, pair), load_quants(activations + block, pair)), accumulator_01);
+			}
+			return _mm512_reduce_add_ps(_mm512_add_ps(accumulator_01, accumulator_02));
+		}
+
+
+		RT_TM_FORCE_INLINE __m512i load_bytes(const void* bytes) noexcept {
+			return _mm512_loadu_si512(bytes);
+		}
+
+		RT_TM_FORCE_INLINE __m512i load_halves(const void* low, const void* high) noexcept {
+			return _mm512_inserti64x4(_mm512_castsi256_si512(_mm256_loadu_si256(static_cast<const __m256i*>(low))),
+				_mm256_loadu_si256(static_cast<const __m256i*>(high)), 1);
+		}
+
+		RT_TM_FORCE_INLINE __m512i get_half_values(int16_t low, int16_t high) noexcept {
+			return _mm512_mask_blend_epi32(0xFF00, _mm512_set1_epi16(low), _mm512_set1_epi16(high));
+		}
+
+		// One int16 scale per 128-bit lane, i.e. per 16 quants.
+		RT_TM_FORCE_INLINE __m512i get_lane_scales(int32_t scale_01, int32_t scale_02, int32_t scale_03, int32_t scale_04) noexcept {
+			const auto pair = [](int32_t scale) {
+				return static_cast<int32_t>(static_cast<uint32_t>(static_cast<uint16_t>(scale)) * 0x00010001u);
+			};
+			return _mm512_set_epi32(pair(scale_04), pair(scale_04), pair(scale_04), pair(scale_04), pair(scale_03), pair(scale_03), pair(scale_03), pair(scale_03),
+				pair(scale_02), pair(scale_02), pair(scale_02), pair(scale_02), pair(scale_01), pair(scale_01), pair(scale_01), pair(scale_01));
+		}
+
+		RT_TM_FORCE_INLINE __m512i dot_scaled(__m512i quants, __m512i activation_quants, __m512i scales) noexcept {
+			return _mm512_madd_epi16(_mm512_maddubs_epi16(quants, activation_quants), scales);
+		}
+
+		// A register holds two 32-element sub-blocks: pair p covers quants[64 * p..], so its low nibbles are
+		// sub-blocks 4p and 4p + 2 and its high nibbles 4p + 1 and 4p + 3.
+		template<bool has_high_bits, typename block_type>
+		RT_TM_FORCE_INLINE float vec_dot_q4_5_k_q8_k(const block_type* weights, const block_q8_k* activations, uint64_t block_count) noexcept {
+			const __m512i low_mask{ _mm512_set1_epi8(0x0F) };
+			const __m512i one{ _mm512_set1_epi8(1) };
+			__m512 accumulator{ _mm512_setzero_ps() };
+			float min_accumulator{};
+			for (uint64_t block = 0; block < block_count; ++block) {
+				uint8_t scales[16];
+				unpack_k_scales(weights[block].scales, scales);
+				__m512i high_bits{};
+				if constexpr (has_high_bits) {
+					high_bits = _mm512_broadcast_i64x4(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(weights[block].high_bits)));
+				}
+				const int8_t* activation_quants{ activations[block].quants };
+				__m512i sum{ _mm512_setzero_si512() };
+				for (int16_t pair = 0; pair < 2; ++pair) {
+					const __m512i bits{ load_bytes(weights[block].quants + pair * 64) };
+					__m512i low{ _mm512_and_si512(bits, low_mask) };
+					__m512i high{ _mm512_and_si512(_mm512_srli_epi16(bits, 4), low_mask) };
+					const int16_t sub{ static_cast<int16_t>(pair * 4) };
+					if constexpr (has_high_bits) {
+						low	 = _mm512_or_si512(low, _mm512_slli_epi16(_mm512_and_si512(_mm512_srlv_epi16(high_bits, get_half_values(sub, sub + 2)), one), 4));
+						high = _mm512_or_si512(high, _mm512_slli_epi16(_mm512_and_si512(_mm512_srlv_epi16(high_bits, get_half_values(sub + 1, sub + 3)), one), 4));
+					}
+					sum = _mm512_add_epi32(sum,
+						dot_scaled(low, load_halves(activation_quants + sub * 32, activation_quants + sub * 32 + 64),
+							get_lane_scales(scales[sub], scales[sub], scales[sub + 2], scales[sub + 2])));
+					sum = _mm512_add_epi32(sum,
+						dot_scaled(high, load_halves(activation_quants + sub * 32 + 32, activation_quants + sub * 32 + 96),
+							get_lane_scales(scales[sub + 1], scales[sub + 1], scales[sub + 3], scales[sub + 3])));
+				}
+				accumulator = _mm512_fmadd_ps(_mm512_set1_ps(activations[block].scale * fp16_to_fp32(weights[block].scale)), _mm512_cvtepi32_ps(sum), accumulator);
+				min_accumulator += activations[block].scale * fp16_to_fp32(weights[block].min_scale) *
+					static_cast<float>(get_k_min_sum(scales + 8, activations[block].block_sums));
+			}
+			return _mm512_reduce_add_ps(accumulator) - min_accumulator;
+		}
+
+		// low_bits[64 * half..] covers q6_k groups 0 and 1 in its low nibbles and groups 2 and 3 in its high nibbles,
+		// so a single load feeds two registers of 64 quants; the implicit -32 is applied through the block sums.
+		RT_TM_FORCE_INLINE __m512i get_q6_k_groups(__m512i low_bits, __m512i high_bits, __m512i high_shifts) noexcept {
+			const __m512i high{ _mm512_and_si512(_mm512_srlv_epi16(high_bits, high_shifts), _mm512_set1_epi8(3)) };
+			return _mm512_or_si512(_mm512_and_si512(low_bits, _mm512_set1_epi8(0x0F)), _mm512_slli_epi16(high, 4));
+		}
+
+		// A tile_rows x tile_tokens register tile stepping over two column blocks per iteration; the weight signs and
+		// magnitudes are worked out once per row and reused by every token of the tile.
+		template<bool vnni, uint64_t tile_tokens> RT_TM_FORCE_INLINE void gemm_q8_0_tile(const block_q8_0* panel, const block_q8_0* activations, uint64_t block_count,
+			uint64_t column_count, float* output, uint64_t output_stride, uint64_t valid_rows) noexcept {
+			__m512 accumulators[gemm_tile_rows][tile_tokens];
+			for (uint64_t row = 0; row < gemm_tile_rows; ++row) {
+				for (uint64_t token = 0; token < tile_tokens; ++token) {
+					accumulators[row][token] = _mm512_setzero_ps();
+				}
+			}
+			for (uint64_t column = 0; column < column_count; column += 2) {
+				const bool pair{ column + 2 <= column_count };
+				__m512i activation_quants[tile_tokens];
+				__m512 activation_scales[tile_tokens];
+				for (uint64_t token = 0; token < tile_tokens; ++token) {
+					const block_q8_0* token_blocks{ activations + token * block_count + column };
+					activation_quants[token] = load_quants(token_blocks, pair);
+					activation_scales[token] = load_scales(token_blocks[0], token_blocks[1], pair);
+				}
+				const block_q8_0* column_blocks{ panel + column * gemm_tile_rows };
+				for (uint64_t row = 0; row < gemm_tile_rows; ++row) {
+					const __m512i weight_quants{ load_quants(column_blocks[row], column_blocks[row + gemm_tile_rows], pair) };
+					const __m512 weight_scales{ load_scales(column_blocks[row], column_blocks[row + gemm_tile_rows], pair) };
+					const __m512i magnitudes{ _mm512_abs_epi8(weight_quants) };
+					const __mmask64 negative{ _mm512_movepi8_mask(weight_quants) };
+					for (uint64_t token = 0; token < tile_tokens; ++token) {
+						accumulators[row][token] = _mm512_fmadd_ps(_mm512_mul_ps(weight_scales, activation_scales[token]),
+							dot_signed<vnni>(magnitudes, negative, activation_quants[token]), accumulators[row][token]);
+					}
+				}
+			}
+			for (uint64_t token = 0; token < tile_tokens; ++token) {
+				for (uint64_t row = 0; row < valid_rows; ++row) {
+					output[token * output_stride + row] += _mm512_reduce_add_ps(accumulators[row][token]);
+				}
+			}
+		}
+
+		template<bool vnni, bool interleaved> RT_TM_FORCE_INLINE void gemm_q8_0_impl(const block_q8_0* weights, const block_q8_0* activations, float* output, uint64_t row_count,
+			uint64_t token_count, uint64_t block_count, uint64_t output_stride, const gemm_blocking& blocking, block_q8_0* panel) noexcept {
+			for (uint64_t token = 0; token < token_count; ++token) {
+				std::fill_n(output + token * output_stride, row_count, 0.0f);
+			}
+			for (uint64_t column_block = 0; column_block < block_count; column_block += blocking.column_blocks) {
+				const uint64_t column_count{ std::min(blocking.column_blocks, block_count - column_block) };
+				for (uint64_t row_block = 0; row_block < row_count; row_block += blocking.row_block) {
+					const uint64_t rows{ std::min(blocking.row_block, row_count - row_block) };
+					if constexpr (!interleaved) {
+						pack_weight_panel(weights + row_block * block_count, rows, block_count, column_block, column_count, gemm_tile_rows, panel);
+					}
+					const auto get_tile = [&](uint64_t row) {
+						if constexpr (interleaved) {
+							return weights + (row_block + row) * block_count + column_block * gemm_tile_rows;
+						} else {
+							return static_cast<const block_q8_0*>(panel + row * column_count);
+						}
+					};
+					uint64_t token{};
+					for (; token + gemm_tile_tokens <= token_count; token += gemm_tile_tokens) {
+						for (uint64_t row = 0; row < rows; row += gemm_tile_rows) {
+							gemm_q8_0_tile<vnni, gemm_tile_tokens>(get_tile(row), activations + token * block_count + column_block, block_count, column_count,
+								output + token * output_stride + row_block + row, output_stride, std::min(gemm_tile_rows, rows - row));
+						}
+					}
+					for (; token < token_count; ++token) {
+						for (uint64_t row = 0; row < rows; row += gemm_tile_rows) {
+							gemm_q8_0_tile<vnni, 1>(get_tile(row), activations + token * block_count + column_block, block_count, column_count,
+								output + token * output_stride + row_block + row, output_stride, std::min(gemm_tile_rows, rows - row));
+						}
+					}
+				}
+			}
+		}
+
+		// Codebook lookup for two 16-byte groups of packed nibbles: each group is spread over two 128-bit lanes (low
+		// nibbles, then high nibbles) and decoded with an in-lane pshufb against the broadcast iq4 table.
+		RT_TM_FORCE_INLINE __m512i get_iq4_values(__m512i bits, __m512i codebook) noexcept {
+			const __m512i low_mask{ _mm512_set1_epi8(0x0F) };
+			const __m512i spread{ _mm512_shuffle_i64x2(bits, bits, 0x50) };
+			const __m512i indices{ _mm512_mask_blend_epi64(0xCC, _mm512_and_si512(spread, low_mask), _mm512_and_si512(_mm512_srli_epi16(spread, 4), low_mask)) };
+			return _mm512_shuffle_epi8(codebook, indices);
+		}
+
+		RT_TM_FORCE_INLINE __m512i load_iq4_codebook() noexcept {
+			return _mm512_broadcast_i32x4(_mm_loadu_si128(reinterpret_cast<const __m128i*>(iq4_values)));
+		}
+
+		RT_TM_FORCE_INLINE __m512i load_iq4_nl_quants(const block_iq4_nl* blocks, bool pair) noexcept {
+			const __m128i low{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(blocks[0].quants)) };
+			const __m128i high{ pair ? _mm_loadu_si128(reinterpret_cast<const __m128i*>(blocks[1].quants)) : _mm_setzero_si128() };
+			return _mm512_castsi256_si512(_mm256_set_m128i(high, low));
+		}
+
+		template<bool vnni> RT_TM_FORCE_INLINE float vec_dot_iq4_nl_q8_0_impl(const block_iq4_nl* weights, const block_q8_0* activations, uint64_t block_count) noexcept {
+			const __m512i codebook{ load_iq4_codebook() };
+			__m512 accumulator{ _mm512_setzero_ps() };
+			for (uint64_t block = 0; block < block_count; block += 2) {
+				const bool pair{ block + 2 <= block_count };
+				const __m512i values{ get_iq4_values(load_iq4_nl_quants(weights + block, pair), codebook) };
+				accumulator = _mm512_fmadd_ps(get_scales(weights + block, activations + block, pair), dot_block_pair<vnni>(values, load_quants(activations + block, pair)),
+					accumulator);
+			}
+			return _mm512_reduce_add_ps(accumulator);
+		}
+
+		// Two iq4_xs sub-blocks per register, weighted by their 6-bit scales per 256-bit half.
+		RT_TM_FORCE_INLINE float vec_dot_iq4_xs_q8_k_impl(const block_iq4_xs* weights, const block_q8_k* activations, uint64_t block_count) noexcept {
+			const __m512i codebook{ load_iq4_codebook() };
+			__m512 accumulator{ _mm512_setzero_ps() };
+			for (uint64_t block = 0; block < block_count; ++block) {
+				__m512i sum{ _mm512_setzero_si512() };
+				for (uint64_t sub = 0; sub < 8; sub += 2) {
+					const __m512i bits{ _mm512_castsi256_si512(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(weights[block].quants + sub * 16))) };
+					const __m512i values{ get_iq4_values(bits, codebook) };
+					const __m512i activation_quants{ load_bytes(activations[block].quants + sub * 32) };
+					const __m512i magnitudes{ _mm512_abs_epi8(values) };
+					const __m512i signed_activations{ _mm512_mask_sub_epi8(activation_quants, _mm512_movepi8_mask(values), _mm512_setzero_si512(), activation_quants) };
+					const __m512i scales{ get_half_values(static_cast<int16_t>(get_iq4_xs_scale(weights[block], sub)), static_cast<int16_t>(get_iq4_xs_scale(weights[block], sub + 1))) };
+					sum = _mm512_add_epi32(sum, dot_scaled(magnitudes, signed_activations, scales));
+				}
+				accumulator = _mm512_fmadd_ps(_mm512_set1_ps(fp16_to_fp32(weights[block].scale) * activations[block].scale), _mm512_cvtepi32_ps(sum), accumulator);
+			}
+			return _mm512_reduce_add_ps(accumulator);
+		}
+	}
+
+	float vec_dot_q8_0_q8_0(const block_q8_0* weights, const block_q8_0* activations, uint64_t block_count) noexcept {
+		return cpu_arch_index_holder::has_avx512_vnni ? vec_dot_q8_0_q8_0_impl<true>(weights, activations, block_count)
+													  : vec_dot_q8_0_q8_0_impl<false>(weights, activations, block_count);
+	}
+
+	void matvec_q8_0(const block_q8_0* weights, const block_q8_0* activations, float* output, uint64_t row_count, uint64_t block_count) noexcept {
+		if (cpu_arch_index_holder::has_avx512_vnni) {
+			for (uint64_t row = 0; row < row_count; ++row) {
+				output[row] = vec_dot_q8_0_q8_0_impl<true>(weights + row * block_count, activations, block_count);
+			}
+		} else {
+			for (uint64_t row = 0; row < row_count; ++row) {
+				output[row] = vec_dot_q8_0_q8_0_impl<false>(weights + row * block_count, activations, block_count);
+			}
+		}
+	}
+
+	float vec_dot_q4_k_q8_k(const block_q4_k* weights, const block_q8_k* activations, uint64_t block_count) noexcept {
+		return vec_dot_q4_5_k_q8_k<false>(weights, activations, block_count);
+	}
+
+	float vec_dot_q5_k_q8_k(const block_q5_k* weights, const block_q8_k* activations, uint64_t block_count) noexcept {
+		return vec_dot_q4_5_k_q8_k<true>(weights, activations, block_count);
+	}
+
+	float vec_dot_q6_k_q8_k(const block_q6_k* weights, const block_q8_k* activations, uint64_t block_count) noexcept {
+		const __m512i high_shifts_01{ get_half_values(0, 2) };
+		const __m512i high_shifts_02{ get_half_values(4, 6) };
+		__m512 accumulator{ _mm512_setzero_ps() };
+		float offset_accumulator{};
+		for (uint64_t block = 0; block < block_count; ++block) {
+			const int8_t* scales{ weights[block].scales };
+			__m512i sum{ _mm512_setzero_si512() };
+			for (uint64_t half = 0; half < 2; ++half) {
+				const __m512i low_bits{ load_bytes(weights[block].low_bits + half * 64) };
+				const __m512i high_bits{ _mm512_broadcast_i64x4(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(weights[block].high_bits + half * 32))) };
+				const int8_t* activation_quants{ activations[block].quants + half * 128 };
+				const int8_t* half_scales{ scales + half * 8 };
+				sum = _mm512_add_epi32(sum,
+					dot_scaled(get_q6_k_groups(low_bits, high_bits, high_shifts_01), load_bytes(activation_quants),
+						get_lane_scales(half_scales[0], half_scales[1], half_scales[2], half_scales[3])));
+				sum = _mm512_add_epi32(sum,
+					dot_scaled(get_q6_k_groups(_mm512_srli_epi16(low_bits, 4), high_bits, high_shifts_02), load_bytes(activation_quants + 64),
+						get_lane_scales(half_scales[4], half_scales[5], half_scales[6], half_scales[7])));
+			}
+			const float scale{ activations[block].scale * fp16_to_fp32(weights[block].scale) };
+			accumulator = _mm512_fmadd_ps(_mm512_set1_ps(scale), _mm512_cvtepi32_ps(sum), accumulator);
+			offset_accumulator += scale * static_cast<float>(get_q6_k_offset_sum(scales, activations[block].block_sums));
+		}
+		return _mm512_reduce_add_ps(accumulator) - offset_accumulator;
+	}
+
+	void matvec_q4_k(const block_q4_k* weights, const block_q8_k* activations, float* output, uint64_t row_count, uint64_t block_count) noexcept {
+		for (uint64_t row = 0; row < row_count; ++row) {
+			output[row] = vec_dot_q4_5_k_q8_k<false>(weights + row * block_count, activations, block_count);
+		}
+	}
+
+	void matvec_q5_k(const block_q5_k* weights, const block_q8_k* activations, float* output, uint64_t row_count, uint64_t block_count) noexcept {
+		for (uint64_t row = 0; row < row_count; ++row) {
+			output[row] = vec_dot_q4_5_k_q8_k<true>(weights + row * block_count, activations, block_count);
+		}
+	}
+
+	void matvec_q6_k(const block_q6_k* weights, const block_q8_k* activations, float* output, uint64_t row_count, uint64_t block_count) noexcept {
+		for (uint64_t row = 0; row < row_count; ++row) {
+			output[row] = avx_512::vec_dot_q6_k_q8_k(weights + row * block_count, activations, block_count);
+		}
+	}
+
+	void gemm_q8_0(const block_q8_0* weights, const block_q8_0* activations, float* output, uint64_t row_count, uint64_t token_count, uint64_t block_count,
+		uint64_t output_stride, const gemm_blocking& blocking, block_q8_0* panel) noexcept {
+		if (cpu_arch_index_holder::has_avx512_vnni) {
+			gemm_q8_0_impl<true, false>(weights, activations, output, row_count, token_count, block_count, output_stride, blocking, panel);
+		} else {
+			gemm_q8_0_impl<false, false>(weights, activations, output, row_count, token_count, block_count, output_stride, blocking, panel);
+		}
+	}
+
+	void gemm_q8_0_interleaved(const block_q8_0* weights, const block_q8_0* activations, float* output, uint64_t row_count, uint64_t token_count,
+		uint64_t block_count, uint64_t output_stride, const gemm_blocking& blocking) noexcept {
+		if (cpu_arch_index_holder::has_avx512_vnni) {
+			gemm_q8_0_impl<true, true>(weights, activations, output, row_count, token_count, block_count, output_stride, blocking, nullptr);
+		} else {
+			gemm_q8_0_impl<false, true>(weights, activations, output, row_count, token_count, block_count, output_stride, blocking, nullptr);
+		}
+	}
+
+	void matvec_q8_0_interleaved(const block_q8_0* weights, const block_q8_0* activations, float* output, uint64_t row_count, uint64_t block_count) noexcept {
+		std::fill_n(output, row_count, 0.0f);
+		if (cpu_arch_index_holder::has_avx512_vnni) {
+			for (uint64_t row = 0; row < row_count; row += gemm_tile_rows) {
+				gemm_q8_0_tile<true, 1>(weights + row * block_count, activations, block_count, block_count, output + row, 0, std::min(gemm_tile_rows, row_count - row));
+			}
+		} else {
+			for (uint64_t row = 0; row < row_count; row += gemm_tile_rows) {
+				gemm_q8_0_tile<false, 1>(weights + row * block_count, activations, block_count, block_count, output + row, 0, std::min(gemm_tile_rows, row_count - row));
+			}
+		}
+	}
+
+	float vec_dot_iq4_nl_q8_0(const block_iq4_nl* weights, const block_q8_0* activations, uint64_t block_count) noexcept {
+		return cpu_arch_index_holder::has_avx512_vnni ? vec_dot_iq4_nl_q8_0_impl<true>(weights, activations, block_count)
+													  : vec_dot_iq4_nl_q8_0_impl<false>(weights, activations, block_count);
+	}
+
+	float vec_dot_iq4_xs_q8_k(const block_iq4_xs* weights, const block_q8_k* activations, uint64_t block_count) noexcept {
+		return vec_dot_iq4_xs_q8_k_impl(weights, activations, block_count);
+	}
+
+	void matvec_iq4_nl(const block_iq4_nl* weights, const block_q8_0* activations, float* output, uint64_t row_count, uint64_t block_count) noexcept {
+		if (cpu_arch_index_holder::has_avx512_vnni) {
+			for (uint64_t row = 0; row < row_count; ++row) {
+				output[row] = vec_dot_iq4_nl_q8_0_impl<true>(weights + row * block_count, activations, block_count);
+			}
+		} else {
+			for (uint64_t row = 0; row < row_count; ++row) {
+				output[row] = vec_dot_iq4_nl_q8_0_impl<false>(weights + row * block_count, activations, block_count);
+			}
+		}
+	}
+
+	void matvec_iq4_xs(const block_iq4_xs* weights, const block_q8_k* activations, float* output, uint64_t row_count, uint64_t block_count) noexcept {
+		for (uint64_t row = 0; row < row_count; ++row) {
+			output[row] = vec_dot_iq4_xs_q8_k_impl(weights + row * block_count, activations, block_count);
+		}
+	}
+
+}
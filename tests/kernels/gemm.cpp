@@ -0,0 +1,74 @@
+/*
+MIT License
+
+Copyright (c) 2025 RealTimeChris (Chris M)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "RT-TM Library"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+This file was independently created by RealTimeChris (Chris M), without reuse
+or derivation from any codebase owned by other entities, including any contract work.
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT
+OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+// mul_mat_q8_0 on row-major weights through the cache-blocked GEMM and through the per-token matvecs, against the
+// scalar tier. The small scratch forces the packed weight panel to give up rows so it fits beside the activations.
+#include "test_common.hpp"
+
+namespace rt_tm_tests {
+
+	struct mul_mat_shape {
+		uint64_t row_count{};
+		uint64_t token_count{};
+		uint64_t block_count{};
+	};
+
+	template<size_t cpu_index> void test_mul_mat_q8_0() {
+		for (const uint64_t scratch_bytes: { uint64_t{ 4 * 1024 * 1024 }, uint64_t{ 64 * 1024 } }) {
+			memory_buffer<config, uint8_t> scratch{ scratch_bytes };
+			cpu_op_context<config> context{ scratch, 0, 1, 0 };
+			for (const mul_mat_shape& current: { mul_mat_shape{ 5, 1, 3 }, mul_mat_shape{ 13, 9, 7 }, mul_mat_shape{ 37, 20, 33 }, mul_mat_shape{ 64, 37, 16 } }) {
+				const uint64_t column_count{ current.block_count * q8_0_block_size };
+				const std::vector<block_q8_0> weights{ get_random_blocks<block_q8_0>(current.row_count * current.block_count) };
+				const std::vector<float> input{ get_random_floats(current.token_count * column_count) };
+				const uint64_t output_count{ current.row_count * current.token_count };
+				std::vector<float> expected(output_count);
+				mul_mat_q8_0<0>(weights.data(), input.data(), expected.data(), current.row_count, current.token_count, column_count, context, UINT64_MAX);
+				for (const uint64_t min_gemm_tokens: { uint64_t{ 1 }, UINT64_MAX }) {
+					std::vector<float> output(output_count);
+					mul_mat_q8_0<cpu_index>(weights.data(), input.data(), output.data(), current.row_count, current.token_count, column_count, context, min_gemm_tokens);
+					const std::string_view name{ min_gemm_tokens == 1 ? "gemm_q8_0" : "matvec_q8_0" };
+					for (uint64_t x = 0; x < output_count; ++x) {
+						if (!check(name, cpu_index, output_count, output[x], expected[x])) {
+							break;
+						}
+					}
+				}
+			}
+		}
+	}
+
+}
+
+int main() {
+	using namespace rt_tm_tests;
+	if (cpu_arch_index_holder::cpu_arch_index >= 1) {
+		test_mul_mat_q8_0<1>();
+	}
+	if (cpu_arch_index_holder::cpu_arch_index >= 2) {
+		test_mul_mat_q8_0<2>();
+	}
+	return report("gemm");
+}
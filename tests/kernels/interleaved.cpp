@@ -0,0 +1,91 @@
+/*
+MIT License
+
+Copyright (c) 2025 RealTimeChris (Chris M)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "RT-TM Library"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+This file was independently created by RealTimeChris (Chris M), without reuse
+or derivation from any codebase owned by other entities, including any contract work.
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT
+OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+// Weights repacked by weight_packer into interleaved row tiles, run through the interleaved GEMM and matvec of
+// mul_mat_q8_0 against the scalar tier on the row-major weights. Row counts that are not whole tiles check the
+// zero padding of the last tile.
+#include "test_common.hpp"
+
+namespace rt_tm_tests {
+
+	struct mul_mat_shape {
+		uint64_t row_count{};
+		uint64_t token_count{};
+		uint64_t block_count{};
+	};
+
+	template<size_t cpu_index> void test_interleaved_mul_mat_q8_0() {
+		using packer = weight_packer<cpu_index>;
+		memory_buffer<config, uint8_t> scratch{ 4 * 1024 * 1024 };
+		cpu_op_context<config> context{ scratch, 0, 1, 0 };
+		for (const mul_mat_shape& current: { mul_mat_shape{ 5, 1, 3 }, mul_mat_shape{ 13, 9, 7 }, mul_mat_shape{ 37, 20, 33 }, mul_mat_shape{ 64, 37, 16 } }) {
+			const uint64_t column_count{ current.block_count * q8_0_block_size };
+			const std::vector<block_q8_0> weights{ get_random_blocks<block_q8_0>(current.row_count * current.block_count) };
+			model_core core{};
+			core.dimensions[0] = column_count;
+			core.dimensions[1] = current.row_count;
+			core.strides[1]	   = current.block_count * sizeof(block_q8_0);
+			core.data		   = weights.data();
+			core.byte_size	   = weights.size() * sizeof(block_q8_0);
+			core.n_dimensions  = 2;
+			core.type		   = data_type::q8_0;
+			core.name		   = "blk.0.ffn_up.weight";
+			const uint64_t interleaved_rows{ packer::get_interleaved_rows(core) };
+			check("interleaved_rows", cpu_index, current.row_count, static_cast<float>(interleaved_rows), static_cast<float>(packer::tile_rows));
+			std::vector<block_q8_0> interleaved(packer::packed_size(core) / sizeof(block_q8_0));
+			packer::pack(core, interleaved.data());
+			const std::vector<float> input{ get_random_floats(current.token_count * column_count) };
+			const uint64_t output_count{ current.row_count * current.token_count };
+			std::vector<float> expected(output_count);
+			mul_mat_q8_0<0>(weights.data(), input.data(), expected.data(), current.row_count, current.token_count, column_count, context, UINT64_MAX);
+			for (const uint64_t min_gemm_tokens: { uint64_t{ 1 }, UINT64_MAX }) {
+				std::vector<float> output(output_count);
+				mul_mat_q8_0<cpu_index>(interleaved.data(), input.data(), output.data(), current.row_count, current.token_count, column_count, context, min_gemm_tokens,
+					interleaved_rows);
+				const std::string_view name{ min_gemm_tokens == 1 ? "gemm_q8_0_interleaved" : "matvec_q8_0_interleaved" };
+				for (uint64_t x = 0; x < output_count; ++x) {
+					if (!check(name, cpu_index, output_count, output[x], expected[x])) {
+						break;
+					}
+				}
+			}
+			// The token embedding is gathered by row, so the packer leaves it alone.
+			core.name = "token_embd.weight";
+			check("token_embd interleaved_rows", cpu_index, current.row_count, static_cast<float>(packer::get_interleaved_rows(core)), 1.0f);
+		}
+	}
+
+}
+
+int main() {
+	using namespace rt_tm_tests;
+	if (cpu_arch_index_holder::cpu_arch_index >= 1) {
+		test_interleaved_mul_mat_q8_0<1>();
+	}
+	if (cpu_arch_index_holder::cpu_arch_index >= 2) {
+		test_interleaved_mul_mat_q8_0<2>();
+	}
+	return report("interleaved");
+}
@@ -0,0 +1,54 @@
+/*
+MIT License
+
+Copyright (c) 2025 RealTimeChris (Chris M)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "RT-TM Library"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+This file was independently created by RealTimeChris (Chris M), without reuse
+or derivation from any codebase owned by other entities, including any contract work.
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT
+OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+// The iq4_nl and iq4_xs codebook kernels of the AVX2 and AVX-512 tiers against their scalar references, and each
+// reference against the rows decoded through iq4_values.
+#include "test_common.hpp"
+
+namespace rt_tm_tests {
+
+	template<size_t cpu_index> void test_tier() {
+		using kernels	= cpu_kernels<cpu_index>;
+		using reference = cpu_kernels<0>;
+		test_vec_dot<cpu_index>("vec_dot_iq4_nl_q8_0", kernels::vec_dot_iq4_nl_q8_0, reference::vec_dot_iq4_nl_q8_0);
+		test_vec_dot<cpu_index>("vec_dot_iq4_xs_q8_k", kernels::vec_dot_iq4_xs_q8_k, reference::vec_dot_iq4_xs_q8_k);
+		test_matvec<cpu_index>("matvec_iq4_nl", kernels::matvec_iq4_nl, reference::matvec_iq4_nl);
+		test_matvec<cpu_index>("matvec_iq4_xs", kernels::matvec_iq4_xs, reference::matvec_iq4_xs);
+	}
+
+}
+
+int main() {
+	using namespace rt_tm_tests;
+	test_reference("vec_dot_iq4_nl_q8_0", cpu_kernels<0>::vec_dot_iq4_nl_q8_0, dequantize_row_iq4_nl);
+	test_reference("vec_dot_iq4_xs_q8_k", cpu_kernels<0>::vec_dot_iq4_xs_q8_k, dequantize_row_iq4_xs);
+	if (cpu_arch_index_holder::cpu_arch_index >= 1) {
+		test_tier<1>();
+	}
+	if (cpu_arch_index_holder::cpu_arch_index >= 2) {
+		test_tier<2>();
+	}
+	return report("iq4");
+}
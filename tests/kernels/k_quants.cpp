@@ -0,0 +1,58 @@
+/*
+MIT License
+
+Copyright (c) 2025 RealTimeChris (Chris M)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "RT-TM Library"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+This file was independently created by RealTimeChris (Chris M), without reuse
+or derivation from any codebase owned by other entities, including any contract work.
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT
+OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+// The fused q4_k, q5_k and q6_k dot products and matvecs of the AVX2 and AVX-512 tiers against the scalar
+// references, and each reference against the dequantized super-blocks, which covers the 6-bit scale and min
+// unpacking and the high bit planes.
+#include "test_common.hpp"
+
+namespace rt_tm_tests {
+
+	template<size_t cpu_index> void test_tier() {
+		using kernels	= cpu_kernels<cpu_index>;
+		using reference = cpu_kernels<0>;
+		test_vec_dot<cpu_index>("vec_dot_q4_k_q8_k", kernels::vec_dot_q4_k_q8_k, reference::vec_dot_q4_k_q8_k);
+		test_vec_dot<cpu_index>("vec_dot_q5_k_q8_k", kernels::vec_dot_q5_k_q8_k, reference::vec_dot_q5_k_q8_k);
+		test_vec_dot<cpu_index>("vec_dot_q6_k_q8_k", kernels::vec_dot_q6_k_q8_k, reference::vec_dot_q6_k_q8_k);
+		test_matvec<cpu_index>("matvec_q4_k", kernels::matvec_q4_k, reference::matvec_q4_k);
+		test_matvec<cpu_index>("matvec_q5_k", kernels::matvec_q5_k, reference::matvec_q5_k);
+		test_matvec<cpu_index>("matvec_q6_k", kernels::matvec_q6_k, reference::matvec_q6_k);
+	}
+
+}
+
+int main() {
+	using namespace rt_tm_tests;
+	test_reference("vec_dot_q4_k_q8_k", cpu_kernels<0>::vec_dot_q4_k_q8_k, dequantize_row_q4_k);
+	test_reference("vec_dot_q5_k_q8_k", cpu_kernels<0>::vec_dot_q5_k_q8_k, dequantize_row_q5_k);
+	test_reference("vec_dot_q6_k_q8_k", cpu_kernels<0>::vec_dot_q6_k_q8_k, dequantize_row_q6_k);
+	if (cpu_arch_index_holder::cpu_arch_index >= 1) {
+		test_tier<1>();
+	}
+	if (cpu_arch_index_holder::cpu_arch_index >= 2) {
+		test_tier<2>();
+	}
+	return report("k_quants");
+}
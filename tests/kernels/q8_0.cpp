@@ -0,0 +1,52 @@
+/*
+MIT License
+
+Copyright (c) 2025 RealTimeChris (Chris M)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "RT-TM Library"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+This file was independently created by RealTimeChris (Chris M), without reuse
+or derivation from any codebase owned by other entities, including any contract work.
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT
+OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+// q8_0 dot products and matvecs of the AVX2 and AVX-512 tiers against the scalar reference, and the reference
+// against the dequantized rows. Block counts include odd values so the pair-wise and remainder paths run; set
+// RT_TM_DISABLE_AVX512_VNNI to cover the non-VNNI AVX-512 path.
+#include "test_common.hpp"
+
+namespace rt_tm_tests {
+
+	template<size_t cpu_index> void test_tier() {
+		using kernels	= cpu_kernels<cpu_index>;
+		using reference = cpu_kernels<0>;
+		test_vec_dot<cpu_index>("vec_dot_q8_0_q8_0", kernels::vec_dot_q8_0_q8_0, reference::vec_dot_q8_0_q8_0);
+		test_matvec<cpu_index>("matvec_q8_0", kernels::matvec_q8_0, reference::matvec_q8_0);
+	}
+
+}
+
+int main() {
+	using namespace rt_tm_tests;
+	test_reference("vec_dot_q8_0_q8_0", cpu_kernels<0>::vec_dot_q8_0_q8_0, dequantize_row_q8_0);
+	if (cpu_arch_index_holder::cpu_arch_index >= 1) {
+		test_tier<1>();
+	}
+	if (cpu_arch_index_holder::cpu_arch_index >= 2) {
+		test_tier<2>();
+	}
+	return report("q8_0");
+}
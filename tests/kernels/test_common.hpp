@@ -0,0 +1,173 @@
+/*
+MIT License
+
+Copyright (c) 2025 RealTimeChris (Chris M)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "RT-TM Library"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+This file was independently created by RealTimeChris (Chris M), without reuse
+or derivation from any codebase owned by other entities, including any contract work.
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT
+OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+// Shared helpers of the kernel tests: random blocks and activations, the tolerance check, and the comparisons of
+// each kernel against its scalar reference and of each scalar reference against a float dot product of its
+// dequantized rows. Every test source includes it and builds into its own executable.
+#pragma once
+
+#include <rt_tm/index.hpp>
+#include <string_view>
+#include <cstdio>
+#include <random>
+#include <vector>
+#include <cmath>
+
+namespace rt_tm_tests {
+
+	using namespace rt_tm;
+
+	inline static constexpr global_config config{ .exceptions = true };
+	inline static constexpr float tolerance{ 1e-3f };
+	inline static constexpr uint64_t block_counts[]{ 1, 2, 3, 7, 16, 33 };
+
+	inline std::mt19937 random_engine{ 42 };
+	inline uint64_t failure_count{};
+
+	inline std::vector<float> get_random_floats(uint64_t count) {
+		std::normal_distribution<float> distribution{ 0.0f, 1.0f };
+		std::vector<float> return_value(count);
+		for (auto& value: return_value) {
+			value = distribution(random_engine);
+		}
+		return return_value;
+	}
+
+	// Random quants and bit planes with small, positive fp16 scales; q8_0 weights come from the quantizer so they stay
+	// within the [-127, 127] range it produces.
+	template<typename block_type> std::vector<block_type> get_random_blocks(uint64_t count) {
+		std::vector<block_type> return_value(count);
+		if constexpr (std::is_same_v<block_type, block_q8_0>) {
+			const std::vector<float> values{ get_random_floats(count * q8_0_block_size) };
+			quantize_row_q8_0(values.data(), return_value.data(), values.size());
+		} else {
+			std::uniform_int_distribution<uint32_t> distribution{ 0, 255 };
+			uint8_t* bytes{ reinterpret_cast<uint8_t*>(return_value.data()) };
+			for (uint64_t x = 0; x < count * sizeof(block_type); ++x) {
+				bytes[x] = static_cast<uint8_t>(distribution(random_engine));
+			}
+			std::uniform_real_distribution<float> scales{ 0.0001f, 0.01f };
+			for (auto& block: return_value) {
+				block.scale = fp32_to_fp16(scales(random_engine));
+				if constexpr (requires { block.min_scale; }) {
+					block.min_scale = fp32_to_fp16(scales(random_engine));
+				}
+			}
+		}
+		return return_value;
+	}
+
+	template<typename block_type> std::vector<block_type> get_activations(uint64_t count) {
+		std::vector<block_type> return_value(count);
+		if constexpr (std::is_same_v<block_type, block_q8_k>) {
+			const std::vector<float> values{ get_random_floats(count * q_k_block_size) };
+			quantize_row_q8_k(values.data(), return_value.data(), values.size());
+		} else {
+			const std::vector<float> values{ get_random_floats(count * q8_0_block_size) };
+			quantize_row_q8_0(values.data(), return_value.data(), values.size());
+		}
+		return return_value;
+	}
+
+	inline bool check(std::string_view name, size_t cpu_index, uint64_t shape, float value, float reference) {
+		if (!(std::fabs(value - reference) <= tolerance * (1.0f + std::fabs(reference)))) {
+			std::printf("FAILED %.*s (cpu index %zu, shape %llu): %g, expected %g\n", static_cast<int>(name.size()), name.data(), cpu_index,
+				static_cast<unsigned long long>(shape), value, reference);
+			++failure_count;
+			return false;
+		}
+		return true;
+	}
+
+	template<size_t cpu_index, typename weight_type, typename activation_type> void test_vec_dot(std::string_view name,
+		float (*kernel)(const weight_type*, const activation_type*, uint64_t), float (*reference)(const weight_type*, const activation_type*, uint64_t)) {
+		for (uint64_t block_count: block_counts) {
+			const std::vector<weight_type> weights{ get_random_blocks<weight_type>(block_count) };
+			const std::vector<activation_type> activations{ get_activations<activation_type>(block_count) };
+			check(name, cpu_index, block_count, kernel(weights.data(), activations.data(), block_count), reference(weights.data(), activations.data(), block_count));
+		}
+	}
+
+	template<size_t cpu_index, typename weight_type, typename activation_type> void test_matvec(std::string_view name,
+		void (*kernel)(const weight_type*, const activation_type*, float*, uint64_t, uint64_t),
+		void (*reference)(const weight_type*, const activation_type*, float*, uint64_t, uint64_t)) {
+		for (uint64_t row_count: { 1, 5, 13 }) {
+			for (uint64_t block_count: block_counts) {
+				const std::vector<weight_type> weights{ get_random_blocks<weight_type>(row_count * block_count) };
+				const std::vector<activation_type> activations{ get_activations<activation_type>(block_count) };
+				std::vector<float> output(row_count);
+				std::vector<float> expected(row_count);
+				kernel(weights.data(), activations.data(), output.data(), row_count, block_count);
+				reference(weights.data(), activations.data(), expected.data(), row_count, block_count);
+				for (uint64_t row = 0; row < row_count; ++row) {
+					if (!check(name, cpu_index, row_count * block_count, output[row], expected[row])) {
+						break;
+					}
+				}
+			}
+		}
+	}
+
+	template<typename activation_type> inline static constexpr uint64_t activation_block_size{ std::is_same_v<activation_type, block_q8_k> ? q_k_block_size : q8_0_block_size };
+
+	inline void dequantize_activations(const block_q8_0* input, float* output, uint64_t count) {
+		dequantize_row_q8_0(input, output, count);
+	}
+
+	inline void dequantize_activations(const block_q8_k* input, float* output, uint64_t count) {
+		for (uint64_t block = 0; block < count / q_k_block_size; ++block) {
+			for (uint64_t x = 0; x < q_k_block_size; ++x) {
+				output[block * q_k_block_size + x] = input[block].scale * static_cast<float>(input[block].quants[x]);
+			}
+		}
+	}
+
+	// The scalar reference against the plain float dot product of the dequantized weight and activation rows, which
+	// ties the integer paths (scales, mins, high bits, codebooks) back to the format's definition.
+	template<typename weight_type, typename activation_type> void test_reference(std::string_view name,
+		float (*reference)(const weight_type*, const activation_type*, uint64_t), void (*dequantize_row)(const weight_type*, float*, uint64_t)) {
+		for (uint64_t block_count: block_counts) {
+			const uint64_t element_count{ block_count * activation_block_size<activation_type> };
+			const std::vector<weight_type> weights{ get_random_blocks<weight_type>(block_count) };
+			const std::vector<activation_type> activations{ get_activations<activation_type>(block_count) };
+			std::vector<float> weight_values(element_count);
+			std::vector<float> activation_values(element_count);
+			dequantize_row(weights.data(), weight_values.data(), element_count);
+			dequantize_activations(activations.data(), activation_values.data(), element_count);
+			double expected{};
+			for (uint64_t x = 0; x < element_count; ++x) {
+				expected += static_cast<double>(weight_values[x]) * static_cast<double>(activation_values[x]);
+			}
+			check(name, 0, block_count, reference(weights.data(), activations.data(), block_count), static_cast<float>(expected));
+		}
+	}
+
+	inline int report(std::string_view name) {
+		std::printf("%.*s: cpu index %zu, avx512 vnni %d: %llu failures\n", static_cast<int>(name.size()), name.data(), cpu_arch_index_holder::cpu_arch_index,
+			cpu_arch_index_holder::has_avx512_vnni, static_cast<unsigned long long>(failure_count));
+		return failure_count == 0 ? 0 : 1;
+	}
+
+}
@@ -0,0 +1,191 @@
+/*
+MIT License
+
+Copyright (c) 2025 RealTimeChris (Chris M)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "RT-TM Library"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+This file was independently created by RealTimeChris (Chris M), without reuse
+or derivation from any codebase owned by other entities, including any contract work.
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT
+OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+// Drives the NUMA placement through a simulated two-node topology: worker-to-node mapping, the fallback for
+// malformed descriptions, place_numa's row splits, replicas and telemetry, and op_graph_base::mul_mat_q8_0 reading
+// each node's slice against the single-threaded result.
+#include <rt_tm/index.hpp>
+#include <string_view>
+#include <cstdlib>
+#include <cstring>
+#include <cstdio>
+#include <random>
+#include <vector>
+#include <cmath>
+
+namespace rt_tm_tests {
+
+	using namespace rt_tm;
+
+	inline static constexpr global_config config{ .exceptions = true, .numa = true };
+	inline static constexpr std::string_view topology_description{ "0-1;2-3" };
+	inline static constexpr uint64_t thread_count{ 4 };
+	inline static constexpr uint64_t replicate_bytes{ 1024 };
+
+	inline uint64_t failure_count{};
+
+	template<typename value_type> bool check(std::string_view name, value_type value, value_type expected) {
+		if (value != expected) {
+			std::printf("%.*s: got %llu, expected %llu\n", static_cast<int>(name.size()), name.data(), static_cast<unsigned long long>(value),
+				static_cast<unsigned long long>(expected));
+			++failure_count;
+			return false;
+		}
+		return true;
+	}
+
+	RT_TM_INLINE void set_topology(const char* description) {
+#if defined(RT_TM_PLATFORM_WINDOWS)
+		_putenv_s(numa_topology::environment_variable.data(), description);
+#else
+		setenv(numa_topology::environment_variable.data(), description, 1);
+#endif
+	}
+
+	inline void test_detect() {
+		set_topology(topology_description.data());
+		const numa_topology topology{ numa_topology::detect() };
+		check("simulated", topology.simulated, true);
+		check("node count", topology.size(), size_t{ 2 });
+		worker_scratch<config> scratch{ thread_count, 4096 };
+		const size_t expected_nodes[]{ 0, 0, 1, 1 };
+		for (size_t x = 0; x < thread_count; ++x) {
+			check("worker node", scratch.get_node(x), expected_nodes[x]);
+		}
+		check("node 0 first worker", scratch.get_node_workers(0).first, size_t{ 0 });
+		check("node 0 last worker", scratch.get_node_workers(0).second, size_t{ 2 });
+		check("node 1 first worker", scratch.get_node_workers(1).first, size_t{ 2 });
+		check("node 1 last worker", scratch.get_node_workers(1).second, size_t{ 4 });
+		// Descriptions without a single valid node fall back to the host's topology.
+		for (const char* malformed: { "x", ";", "-;," }) {
+			set_topology(malformed);
+			const numa_topology fallback{ numa_topology::detect() };
+			check("fallback simulated", fallback.simulated, false);
+			check("fallback has nodes", fallback.size() >= 1, true);
+		}
+		set_topology(topology_description.data());
+		check("out of range node bind", bind_pages_to_node(topology, nullptr, 0, 7), false);
+		check("empty topology pin", pin_worker(numa_topology{}, 0, 1), false);
+	}
+
+	struct test_tensor {
+		uint64_t row_count{};
+		uint64_t block_count{};
+		std::vector<block_q8_0> blocks{};
+	};
+
+	inline test_tensor get_random_tensor(std::mt19937& random_engine, uint64_t row_count, uint64_t block_count) {
+		std::normal_distribution<float> distribution{ 0.0f, 1.0f };
+		std::vector<float> values(row_count * block_count * q8_0_block_size);
+		for (auto& value: values) {
+			value = distribution(random_engine);
+		}
+		test_tensor return_value{ row_count, block_count, std::vector<block_q8_0>(row_count * block_count) };
+		quantize_row_q8_0(values.data(), return_value.blocks.data(), values.size());
+		return return_value;
+	}
+
+	inline model_core get_core(const test_tensor& tensor) {
+		model_core return_value{};
+		return_value.dimensions[0] = tensor.block_count * q8_0_block_size;
+		return_value.dimensions[1] = tensor.row_count;
+		return_value.strides[0]	   = sizeof(block_q8_0);
+		return_value.strides[1]	   = tensor.block_count * sizeof(block_q8_0);
+		return_value.data		   = tensor.blocks.data();
+		return_value.byte_size	   = tensor.blocks.size() * sizeof(block_q8_0);
+		return_value.n_dimensions  = 2;
+		return_value.type		   = data_type::q8_0;
+		return return_value;
+	}
+
+	inline void test_place_numa() {
+		std::mt19937 random_engine{ 42 };
+		// 4 rows of 2 blocks stay under replicate_bytes and are replicated; 37 rows are split between the two nodes.
+		const test_tensor tensors[]{ get_random_tensor(random_engine, 4, 2), get_random_tensor(random_engine, 37, 2) };
+		const numa_topology topology{ numa_topology::from_description(topology_description) };
+		model_graph graph{};
+		for (const test_tensor& tensor: tensors) {
+			graph.model_cores.emplace_back(get_core(tensor));
+		}
+		const numa_telemetry telemetry{ graph.place_numa(topology, replicate_bytes) };
+		const uint64_t replicated_bytes{ tensors[0].blocks.size() * sizeof(block_q8_0) };
+		const uint64_t split_bytes{ tensors[1].blocks.size() * sizeof(block_q8_0) };
+		check("telemetry node count", telemetry.node_count, uint64_t{ 2 });
+		check("telemetry bytes replicated", telemetry.bytes_replicated, replicated_bytes * 2);
+		check("telemetry bytes split", telemetry.bytes_split, split_bytes);
+		check("telemetry pages requested", telemetry.pages_requested >= 4, true);
+		check("telemetry pages bound", telemetry.pages_bound, uint64_t{ 0 });
+		check("placement count", graph.numa_placements.size(), size_t{ 2 });
+		check("replica count", graph.numa_placements[0].replicas.size(), size_t{ 2 });
+		check("replicated row splits", graph.numa_placements[0].row_splits.size(), size_t{ 0 });
+		check("distinct replicas", graph.numa_placements[0].replicas[0] != graph.numa_placements[0].replicas[1], true);
+		for (size_t node = 0; node < 2; ++node) {
+			check("replica data", std::memcmp(graph.get_node_data(0, node), tensors[0].blocks.data(), replicated_bytes), 0);
+			check("node data", graph.get_node_data(0, node) == graph.numa_placements[0].replicas[node], true);
+		}
+		const std::vector<uint64_t>& row_splits{ graph.numa_placements[1].row_splits };
+		check("split count", row_splits.size(), size_t{ 3 });
+		check("split 0", row_splits[0], uint64_t{ 0 });
+		check("split 1", row_splits[1], uint64_t{ 18 });
+		check("split 2", row_splits[2], uint64_t{ 37 });
+		check("split replicas", graph.numa_placements[1].replicas.size(), size_t{ 0 });
+		check("split data", std::memcmp(graph.model_cores[1].data, tensors[1].blocks.data(), split_bytes), 0);
+
+		// Every worker computes its node's share of the rows; together they must match one worker doing all of them.
+		op_graph_base<config, impl_indices{}> ops{ op_graph_config{ .num_threads = thread_count, .scratch_bytes_per_thread = 256 * 1024, .gemm_token_threshold = 8 } };
+		memory_buffer<config, uint8_t> scratch{ 1024 * 1024 };
+		cpu_op_context<config> context{ scratch, 0, 1, 0 };
+		for (size_t x = 0; x < 2; ++x) {
+			const uint64_t column_count{ tensors[x].block_count * q8_0_block_size };
+			for (uint64_t token_count: { 1, 9 }) {
+				std::normal_distribution<float> distribution{ 0.0f, 1.0f };
+				std::vector<float> input(token_count * column_count);
+				for (auto& value: input) {
+					value = distribution(random_engine);
+				}
+				std::vector<float> expected(token_count * tensors[x].row_count);
+				std::vector<float> output(expected.size(), NAN);
+				mul_mat_q8_0<0>(tensors[x].blocks.data(), input.data(), expected.data(), tensors[x].row_count, token_count, column_count, context, 8);
+				for (size_t thread = 0; thread < thread_count; ++thread) {
+					ops.mul_mat_q8_0(thread, graph, x, input.data(), output.data(), token_count);
+				}
+				for (size_t y = 0; y < output.size(); ++y) {
+					if (!check("mul_mat_q8_0", std::memcmp(&output[y], &expected[y], sizeof(float)) == 0, true)) {
+						break;
+					}
+				}
+			}
+		}
+	}
+
+}
+
+int main() {
+	using namespace rt_tm_tests;
+	test_detect();
+	test_place_numa();
+	std::printf("numa: %llu failures\n", static_cast<unsigned long long>(failure_count));
+	return failure_count == 0 ? 0 : 1;
+}